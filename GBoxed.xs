@@ -77,6 +77,7 @@ the object was to be freed.
 /* there's still one list open! */
 
 #include "gperl.h"
+#include "gperl-private.h" /* for GPERL_SET_CONTEXT */
 
 /* #define NOISY */
 
@@ -90,6 +91,11 @@ boxed type's mapping from C to perl.  we keep two hashes of these structures,
 one indexed by GType, the other by perl package name, for quick and easy
 lookup.
 
+BoxedInfos stored in info_by_gtype are never freed, not even when a type is
+registered again; the old one is retired instead.  that lets us keep a small
+lock-free cache of them in front of info_by_gtype (see boxed_info_lookup),
+since a pointer read from the cache always points to valid memory.
+
 the fundamental job of this mapping is to tell us what perl package 
 corresponds to a particular GType.
 
@@ -114,8 +120,24 @@ struct _BoxedInfo {
 	GType                    gtype;
 	char                   * package;
 	GPerlBoxedWrapperClass * wrapper_class;
+	/* the key under which this info lives in info_by_gtype; differs
+	 * from gtype for synonyms.  used to validate cache hits. */
+	GType                    key_gtype;
 };
 
+/* BoxedInfos replaced by a later registration; they might still be
+ * referenced from boxed_info_cache or info_by_package.  protected by
+ * the info_by_gtype lock. */
+static GSList * retired_boxed_infos = NULL;
+
+/* a direct-mapped cache of info_by_gtype, read without taking a lock.
+ * entries are only ever stored while holding the info_by_gtype lock. */
+#define BOXED_INFO_CACHE_SIZE 64
+#define BOXED_INFO_CACHE_SLOT(gtype) \
+	((((gsize) (gtype)) ^ (((gsize) (gtype)) >> 9)) >> 3 \
+	 & (BOXED_INFO_CACHE_SIZE - 1))
+static BoxedInfo * boxed_info_cache[BOXED_INFO_CACHE_SIZE];
+
 
 static BoxedInfo *
 boxed_info_new (GType gtype,
@@ -127,6 +149,7 @@ boxed_info_new (GType gtype,
 	boxed_info->gtype = gtype;
 	boxed_info->package = package ? g_strdup (package) : NULL;
 	boxed_info->wrapper_class = wrapper_class;
+	boxed_info->key_gtype = gtype;
 	return boxed_info;
 }
 
@@ -140,17 +163,47 @@ boxed_info_copy (BoxedInfo * boxed_info)
 	return new_boxed_info;
 }
 
+/* must be called with info_by_gtype locked. */
 static void
-boxed_info_destroy (BoxedInfo * boxed_info)
+boxed_info_insert (GType gtype, BoxedInfo * boxed_info)
 {
-	if (boxed_info) {
-		boxed_info->gtype = 0;
-		if (boxed_info->package)
-			g_free (boxed_info->package);
-		boxed_info->package = NULL;
-		boxed_info->wrapper_class = NULL;
-		g_free (boxed_info);
+	BoxedInfo * old_boxed_info;
+	guint slot = BOXED_INFO_CACHE_SLOT (gtype);
+
+	old_boxed_info = (BoxedInfo *)
+		g_hash_table_lookup (info_by_gtype, (gpointer) gtype);
+	if (old_boxed_info) {
+		if (g_atomic_pointer_get (&boxed_info_cache[slot])
+		    == old_boxed_info)
+			g_atomic_pointer_set (&boxed_info_cache[slot], NULL);
+		retired_boxed_infos = g_slist_prepend (retired_boxed_infos,
+		                                       old_boxed_info);
 	}
+	boxed_info->key_gtype = gtype;
+	g_hash_table_insert (info_by_gtype, (gpointer) gtype, boxed_info);
+}
+
+/* look up the BoxedInfo for gtype, without locking if it's cached. */
+static BoxedInfo *
+boxed_info_lookup (GType gtype)
+{
+	BoxedInfo * boxed_info;
+	guint slot = BOXED_INFO_CACHE_SLOT (gtype);
+
+	boxed_info = (BoxedInfo *) g_atomic_pointer_get (&boxed_info_cache[slot]);
+	if (boxed_info && boxed_info->key_gtype == gtype)
+		return boxed_info;
+
+	G_LOCK (info_by_gtype);
+	boxed_info = info_by_gtype
+	           ? (BoxedInfo *) g_hash_table_lookup (info_by_gtype,
+	                                                (gpointer) gtype)
+	           : NULL;
+	if (boxed_info)
+		g_atomic_pointer_set (&boxed_info_cache[slot], boxed_info);
+	G_UNLOCK (info_by_gtype);
+
+	return boxed_info;
 }
 
 =item void gperl_register_boxed (GType gtype, const char * package, GPerlBoxedWrapperClass * wrapper_class)
@@ -185,11 +238,8 @@ gperl_register_boxed (GType gtype,
 	G_LOCK (info_by_package);
 
 	if (!info_by_gtype) {
-		info_by_gtype = g_hash_table_new_full (g_direct_hash,
-						       g_direct_equal,
-						       NULL, 
-						       (GDestroyNotify)
-							 boxed_info_destroy);
+		info_by_gtype = g_hash_table_new (g_direct_hash,
+						  g_direct_equal);
 		info_by_package = g_hash_table_new_full (g_str_hash,
 						         g_str_equal,
 						         NULL, 
@@ -197,17 +247,13 @@ gperl_register_boxed (GType gtype,
 	}
 	boxed_info = boxed_info_new (gtype, package, wrapper_class);
 
-	/* We need to insert into info_by_package first because there might
-	 * otherwise be trouble if we overwrite an entry: inserting into
-	 * info_by_gtype frees the boxed_info of the overwritten entry, so that
-	 * boxed_info->package is no longer valid at this point.
-	 *
-	 * Note also it's g_hash_table_replace() for info_by_package,
-	 * because the old key string in the old boxed_info will be freed
-	 * when info_by_gtype updates the value there.
+	/* It's g_hash_table_replace() for info_by_package so that the key
+	 * string belongs to the new boxed_info.  An overwritten boxed_info
+	 * is retired rather than freed, so its package stays valid for any
+	 * alias still pointing at it.
 	 */
 	g_hash_table_replace (info_by_package, boxed_info->package, boxed_info);
-	g_hash_table_insert (info_by_gtype, (gpointer) gtype, boxed_info);
+	boxed_info_insert (gtype, boxed_info);
 
 	/* GBoxed types are plain structures, so it would be really
 	 * surprising to find a boxed type that actually inherits another
@@ -249,10 +295,7 @@ gperl_register_boxed_alias (GType gtype,
 {
 	BoxedInfo * boxed_info;
 
-	G_LOCK (info_by_gtype);
-	boxed_info = (BoxedInfo *)
-		g_hash_table_lookup (info_by_gtype, (gpointer) gtype);
-	G_UNLOCK (info_by_gtype);
+	boxed_info = boxed_info_lookup (gtype);
 
 	if (!boxed_info) {
 		croak ("cannot register alias %s for the unregistered type %s",
@@ -261,8 +304,8 @@ gperl_register_boxed_alias (GType gtype,
 
 	G_LOCK (info_by_package);
 	/* associate package with the same boxed_info.  boxed_info is still
-	   owned by info_by_gtype.  info_by_package doesn't have a
-	   free-function installed, so that's ok. */
+	   owned by info_by_gtype, which never frees it.  info_by_package
+	   doesn't have a free-function installed, so that's ok. */
 	g_hash_table_insert (info_by_package, (char *) package, boxed_info);
 	G_UNLOCK (info_by_package);
 }
@@ -297,8 +340,7 @@ gperl_register_boxed_synonym (GType registered_gtype,
 	}
 
 	synonym_boxed_info = boxed_info_copy (registered_boxed_info);
-	g_hash_table_insert (info_by_gtype, (gpointer) synonym_gtype,
-	                     synonym_boxed_info);
+	boxed_info_insert (synonym_gtype, synonym_boxed_info);
 
 	G_UNLOCK (info_by_gtype);
 }
@@ -337,12 +379,7 @@ gperl_boxed_package_from_type (GType type)
 {
 	BoxedInfo * boxed_info;
 
-	G_LOCK (info_by_gtype);
-
-	boxed_info = (BoxedInfo*)
-		g_hash_table_lookup (info_by_gtype, (gpointer) type);
-
-	G_UNLOCK (info_by_gtype);
+	boxed_info = boxed_info_lookup (type);
 
 	if (!boxed_info)
 		return NULL;
@@ -376,7 +413,11 @@ boxed_wrapper_new (gpointer boxed,
                    gboolean free_on_destroy)
 {
 	BoxedWrapper * boxed_wrapper;
+#if GLIB_CHECK_VERSION (2, 10, 0)
+	boxed_wrapper = g_slice_new (BoxedWrapper);
+#else
 	boxed_wrapper = g_new (BoxedWrapper, 1);
+#endif
 	boxed_wrapper->boxed = boxed;
 	boxed_wrapper->gtype = gtype;
 	boxed_wrapper->free_on_destroy = free_on_destroy;
@@ -389,7 +430,11 @@ boxed_wrapper_destroy (BoxedWrapper * boxed_wrapper)
 	if (boxed_wrapper) {
 		if (boxed_wrapper->free_on_destroy)
 			g_boxed_free (boxed_wrapper->gtype, boxed_wrapper->boxed);
+#if GLIB_CHECK_VERSION (2, 10, 0)
+		g_slice_free (BoxedWrapper, boxed_wrapper);
+#else
 		g_free (boxed_wrapper);
+#endif
 	} else {
 		warn ("boxed_wrapper_destroy called on NULL pointer");
 	}
@@ -509,12 +554,7 @@ gperl_new_boxed (gpointer boxed,
 		return &PL_sv_undef;
 	}
 
-	G_LOCK (info_by_gtype);
-
-	boxed_info = (BoxedInfo*)
-		g_hash_table_lookup (info_by_gtype, (gpointer) gtype);
-
-	G_UNLOCK (info_by_gtype);
+	boxed_info = boxed_info_lookup (gtype);
 
 	if (!boxed_info)
 		croak ("GType %s (%lu) is not registered with gperl",
@@ -564,9 +604,7 @@ gperl_get_boxed_check (SV * sv, GType gtype)
 		croak ("variable not allowed to be undef where %s is wanted",
 		       g_type_name (gtype));
 
-	G_LOCK (info_by_gtype);
-	boxed_info = g_hash_table_lookup (info_by_gtype, (gpointer) gtype);
-	G_UNLOCK (info_by_gtype);
+	boxed_info = boxed_info_lookup (gtype);
 
 	if (!boxed_info)
 		croak ("internal problem: GType %s (%lu) has not been registered with GPerl",
@@ -589,6 +627,30 @@ gperl_get_boxed_check (SV * sv, GType gtype)
 
 
 
+#if GLIB_CHECK_VERSION (2, 32, 0)
+
+/* Glib::Bytes::new_borrowed keeps the SV owning the buffer alive with this. */
+static void
+bytes_release_sv (gpointer data)
+{
+	GPERL_SET_CONTEXT;
+	SvREFCNT_dec ((SV *) data);
+}
+
+/* Glib::Bytes::get_data_borrowed returns strings pointing into the GBytes;
+ * this magic holds the reference keeping that memory alive. */
+static int
+bytes_data_free (pTHX_ SV * sv, MAGIC * mg)
+{
+	PERL_UNUSED_VAR (sv);
+	g_bytes_unref ((GBytes *) mg->mg_ptr);
+	return 0;
+}
+
+static MGVTBL bytes_data_vtbl = { 0, 0, 0, 0, bytes_data_free };
+
+#endif
+
 static BoxedInfo *
 lookup_known_package_recursive (const char * package)
 {
@@ -931,6 +993,37 @@ g_bytes_new (class, SV *data)
     OUTPUT:
 	RETVAL
 
+=for apidoc
+Creates a new Glib::Bytes object over the string buffer of I<$data> without
+copying it.  If I<$data> is a read-only byte string, its buffer is used
+directly.  Otherwise I<$data> is copied into a private read-only scalar first;
+on perls with copy-on-write strings, that copy shares the buffer too.  The
+scalar is kept alive for as long as the Glib::Bytes object needs it.
+=cut
+GBytes_own *
+new_borrowed (class, SV *data)
+    PREINIT:
+	SV *keep;
+	const char *real_data;
+	STRLEN len;
+    CODE:
+	if (SvREADONLY (data) && SvPOK (data) &&
+	    !SvUTF8 (data) && !SvGMAGICAL (data)) {
+		keep = SvREFCNT_inc (data);
+		real_data = SvPVX (data);
+		len = SvCUR (data);
+	} else {
+		/* mortal until we know SvPVbyte didn't croak */
+		keep = sv_2mortal (newSVsv (data));
+		real_data = SvPVbyte (keep, len);
+		SvREADONLY_on (keep);
+		SvREFCNT_inc (keep);
+	}
+	RETVAL = g_bytes_new_with_free_func (real_data, len,
+	                                     bytes_release_sv, keep);
+    OUTPUT:
+	RETVAL
+
 SV *
 g_bytes_get_data (GBytes *bytes)
     PREINIT:
@@ -942,6 +1035,36 @@ g_bytes_get_data (GBytes *bytes)
     OUTPUT:
 	RETVAL
 
+=for apidoc
+Returns the contents of I<$bytes> as a read-only string which points directly
+at the memory of I<$bytes> instead of holding a copy; the string keeps I<$bytes>
+alive.  Note that, unlike other perl strings, the buffer is not followed by a
+NUL byte, so the string should not be passed to code that relies on one.
+Assigning the string to a variable copies it; use it directly, for example as
+an argument to C<print> or C<syswrite>, to avoid the copy.
+=cut
+SV *
+get_data_borrowed (GBytes *bytes)
+    PREINIT:
+	gconstpointer data;
+	gsize size;
+    CODE:
+	data = g_bytes_get_data (bytes, &size);
+	if (size) {
+		RETVAL = newSV_type (SVt_PVMG);
+		sv_magicext (RETVAL, NULL, PERL_MAGIC_ext, &bytes_data_vtbl,
+		             (const char *) g_bytes_ref (bytes), 0);
+		SvPV_set (RETVAL, (char *) data);
+		SvCUR_set (RETVAL, size);
+		SvLEN_set (RETVAL, 0);
+		SvPOK_only (RETVAL);
+		SvREADONLY_on (RETVAL);
+	} else {
+		RETVAL = newSVpvn ("", 0);
+	}
+    OUTPUT:
+	RETVAL
+
 gsize g_bytes_get_size (GBytes *bytes);
 
 guint g_bytes_hash (GBytes *bytes);
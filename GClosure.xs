@@ -69,6 +69,78 @@ gperl_closure_invalidate (gpointer data,
 	(_gperl_get_main_tid () != g_thread_self ())
 #endif
 
+/*
+ * Signal handlers are by far the most frequent users of the default
+ * marshaller, and the parameter types of a signal never change.  So the
+ * first time a closure is invoked for a signal, we resolve a converter for
+ * each parameter and for the return value, and remember them by signal id.
+ * Values whose type differs from the one declared for the signal (possible
+ * with g_signal_emitv) still take the generic path.  Only closures connected
+ * with gperl_signal_connect use this, and only when the hint names the very
+ * signal they were connected to; anybody else may pass any hint at all.
+ */
+typedef struct {
+	guint                        n_params;
+	const GPerlValueConverter ** param_converters;
+	const GPerlValueConverter  * return_converter; /* NULL for void */
+} MarshalSignature;
+
+static GHashTable * signatures_by_signal_id = NULL;
+G_LOCK_DEFINE_STATIC (signatures_by_signal_id);
+
+static MarshalSignature *
+marshal_signature_lookup (guint signal_id)
+{
+	MarshalSignature * signature;
+	GSignalQuery query;
+	GType return_type;
+	guint i;
+
+	G_LOCK (signatures_by_signal_id);
+	if (!signatures_by_signal_id)
+		signatures_by_signal_id =
+			g_hash_table_new (g_direct_hash, g_direct_equal);
+	signature = g_hash_table_lookup (signatures_by_signal_id,
+					 GUINT_TO_POINTER (signal_id));
+	G_UNLOCK (signatures_by_signal_id);
+
+	if (signature)
+		return signature;
+
+	g_signal_query (signal_id, &query);
+	if (!query.signal_id)
+		return NULL;
+
+	signature = g_new0 (MarshalSignature, 1);
+	signature->n_params = query.n_params;
+	signature->param_converters =
+		g_new0 (const GPerlValueConverter *, query.n_params + 1);
+	for (i = 0 ; i < query.n_params ; i++)
+		signature->param_converters[i] =
+			_gperl_value_converter_lookup
+				(query.param_types[i] & ~G_SIGNAL_TYPE_STATIC_SCOPE);
+	return_type = query.return_type & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+	if (return_type != G_TYPE_NONE)
+		signature->return_converter =
+			_gperl_value_converter_lookup (return_type);
+
+	G_LOCK (signatures_by_signal_id);
+	if (g_hash_table_lookup (signatures_by_signal_id,
+				 GUINT_TO_POINTER (signal_id))) {
+		/* lost a race; use the winner's. */
+		g_free (signature->param_converters);
+		g_free (signature);
+		signature = g_hash_table_lookup (signatures_by_signal_id,
+						 GUINT_TO_POINTER (signal_id));
+	} else {
+		g_hash_table_insert (signatures_by_signal_id,
+				     GUINT_TO_POINTER (signal_id), signature);
+	}
+	G_UNLOCK (signatures_by_signal_id);
+
+	return signature;
+}
+
 static void _closure_hand_to_main (GClosure * closure,
                                    GValue * return_value,
                                    guint n_param_values,
@@ -76,6 +148,12 @@ static void _closure_hand_to_main (GClosure * closure,
                                    gpointer invocation_hint,
                                    gpointer marshal_data);
 
+static gint async_foreign_dispatch = FALSE;
+static void _closure_queue_for_main (GClosure * closure,
+                                     guint n_param_values,
+                                     const GValue * param_values,
+                                     gpointer invocation_hint);
+
 static void
 gperl_closure_marshal (GClosure * closure,
 		       GValue * return_value,
@@ -87,6 +165,7 @@ gperl_closure_marshal (GClosure * closure,
 	gboolean want_return_value;
 	int flags;
 	guint i;
+	MarshalSignature * signature = NULL;
 	dGPERL_CLOSURE_MARSHAL_ARGS;
 
 	/* If the current thread doesn't have a Perl context associated with
@@ -102,21 +181,41 @@ gperl_closure_marshal (GClosure * closure,
 		g_printerr ("*** GPerl asked to invoke callback from a foreign thread; "
 		            "handing it over to the main loop\n");
 #endif
-		_closure_hand_to_main (closure, return_value,
-		                       n_param_values, param_values,
-		                       invocation_hint, marshal_data);
+		/* nobody is waiting for a return value, so if allowed, don't
+		 * make the calling thread wait either. */
+		if (g_atomic_int_get (&async_foreign_dispatch) &&
+		    !(return_value && G_VALUE_TYPE (return_value)))
+			_closure_queue_for_main (closure,
+			                         n_param_values, param_values,
+			                         invocation_hint);
+		else
+			_closure_hand_to_main (closure, return_value,
+			                       n_param_values, param_values,
+			                       invocation_hint, marshal_data);
 		return;
 	}
 
 	GPERL_CLOSURE_MARSHAL_INIT (closure, marshal_data);
 
-	PERL_UNUSED_VAR (invocation_hint);
+	/* when invoked for the emission of the signal we're connected to,
+	 * the hint tells us which. */
+	if (invocation_hint && n_param_values > 0 && pc->signal_id &&
+	    ((GSignalInvocationHint *) invocation_hint)->signal_id
+	    == pc->signal_id) {
+		signature = marshal_signature_lookup
+			(((GSignalInvocationHint *) invocation_hint)->signal_id);
+		if (signature && signature->n_params + 1 != n_param_values)
+			signature = NULL;
+	}
 
 	ENTER;
 	SAVETMPS;
 
 	PUSHMARK (SP);
 
+	/* room for the instance, the params and the data, all at once. */
+	EXTEND (SP, (int) n_param_values + 1);
+
 	if (n_param_values == 0) {
 		data = SvREFCNT_inc (pc->data);
 	} else {
@@ -124,10 +223,16 @@ gperl_closure_marshal (GClosure * closure,
 
 		/* the rest of the params should be quite straightforward. */
 		for (i = 1; i < n_param_values; i++) {
+			const GValue * value = param_values + i;
+			const GPerlValueConverter * converter = signature
+				? signature->param_converters[i - 1]
+				: NULL;
 			SV * arg = SAVED_STACK_SV (
-				gperl_sv_from_value ((GValue*) param_values + i));
+				converter && G_VALUE_TYPE (value) == converter->gtype
+				? _gperl_converter_sv_from_value (converter, value, FALSE)
+				: gperl_sv_from_value (value));
 			/* make these mortal as they go onto the stack */
-			XPUSHs (sv_2mortal (arg));
+			PUSHs (sv_2mortal (arg));
 		}
 	}
 	GPERL_CLOSURE_MARSHAL_PUSH_DATA;
@@ -143,7 +248,14 @@ gperl_closure_marshal (GClosure * closure,
 	PERL_UNUSED_VAR (count);
 
 	if (want_return_value) {
-		gperl_value_from_sv (return_value, POPs);
+		SV * ret = POPs;
+		const GPerlValueConverter * converter = signature
+			? signature->return_converter
+			: NULL;
+		if (converter && G_VALUE_TYPE (return_value) == converter->gtype)
+			_gperl_converter_value_from_sv (converter, return_value, ret);
+		else
+			gperl_value_from_sv (return_value, ret);
 		PUTBACK; /* vitally important */
 	}
 
@@ -229,6 +341,169 @@ _closure_hand_to_main (GClosure * closure,
 #endif /* 2.32 */
 }
 
+/*
+ * The asynchronous alternative to _closure_hand_to_main: invocations from
+ * foreign threads are copied and pushed onto a lock-free list, and a single
+ * GSource attached to the default main context runs everything that has
+ * piled up in one go.  Producers push with compare-and-exchange; the
+ * consumer takes the whole list at once, so there is no ABA problem.  Only
+ * the push that finds the list empty needs to wake up the main loop.
+ */
+typedef struct _PendingInvocation PendingInvocation;
+struct _PendingInvocation {
+	PendingInvocation     * next;
+	GClosure              * closure;
+	guint                   n_param_values;
+	GValue                * param_values;
+	gboolean                has_hint;
+	GSignalInvocationHint   hint;
+};
+
+static gpointer pending_invocations = NULL;
+static GSource * pending_invocations_source = NULL;
+G_LOCK_DEFINE_STATIC (pending_invocations_source);
+
+static void
+_closure_queue_for_main (GClosure * closure,
+                         guint n_param_values,
+                         const GValue * param_values,
+                         gpointer invocation_hint)
+{
+	PendingInvocation * inv;
+	gpointer head;
+	guint i;
+
+	inv = g_new0 (PendingInvocation, 1);
+	inv->closure = g_closure_ref (closure);
+	inv->n_param_values = n_param_values;
+	inv->param_values = g_new0 (GValue, n_param_values);
+	for (i = 0 ; i < n_param_values ; i++) {
+		g_value_init (&inv->param_values[i],
+		              G_VALUE_TYPE (&param_values[i]));
+		g_value_copy (&param_values[i], &inv->param_values[i]);
+	}
+	if (invocation_hint) {
+		inv->has_hint = TRUE;
+		inv->hint = *(GSignalInvocationHint *) invocation_hint;
+	}
+
+	do {
+		head = g_atomic_pointer_get (&pending_invocations);
+		inv->next = head;
+	} while (!g_atomic_pointer_compare_and_exchange (&pending_invocations,
+	                                                 head, inv));
+
+	if (!head)
+		g_main_context_wakeup (NULL);
+}
+
+static gboolean
+pending_invocations_prepare (GSource * source,
+                             gint * timeout)
+{
+	PERL_UNUSED_VAR (source);
+	*timeout = -1;
+	return g_atomic_pointer_get (&pending_invocations) != NULL;
+}
+
+static gboolean
+pending_invocations_check (GSource * source)
+{
+	PERL_UNUSED_VAR (source);
+	return g_atomic_pointer_get (&pending_invocations) != NULL;
+}
+
+static gboolean
+pending_invocations_dispatch (GSource * source,
+                              GSourceFunc callback,
+                              gpointer user_data)
+{
+	PendingInvocation * list, * inv, * fifo = NULL;
+
+	PERL_UNUSED_VAR (source);
+	PERL_UNUSED_VAR (callback);
+	PERL_UNUSED_VAR (user_data);
+
+	do {
+		list = g_atomic_pointer_get (&pending_invocations);
+	} while (list &&
+	         !g_atomic_pointer_compare_and_exchange (&pending_invocations,
+	                                                 list, NULL));
+
+	/* the list is newest-first; run things in the order they came in. */
+	while (list) {
+		inv = list;
+		list = list->next;
+		inv->next = fifo;
+		fifo = inv;
+	}
+
+	while (fifo) {
+		guint i;
+
+		inv = fifo;
+		fifo = fifo->next;
+
+		/* g_closure_invoke skips closures that have been invalidated
+		 * in the meantime, e.g. by disconnecting the handler. */
+		g_closure_invoke (inv->closure, NULL,
+		                  inv->n_param_values, inv->param_values,
+		                  inv->has_hint ? &inv->hint : NULL);
+
+		for (i = 0 ; i < inv->n_param_values ; i++)
+			g_value_unset (&inv->param_values[i]);
+		g_free (inv->param_values);
+		g_closure_unref (inv->closure);
+		g_free (inv);
+	}
+
+	return TRUE;
+}
+
+=item void gperl_closure_set_async_foreign_dispatch (gboolean async)
+
+When a GPerlClosure is invoked from a thread that has no perl interpreter,
+the invocation is handed to the main loop, and by default the calling thread
+blocks until the main loop has run the callback.  If I<async> is TRUE, this
+function changes that for invocations that do not want a return value, e.g.
+void signals.  Their parameters are copied and queued, the calling thread
+continues right away, and the main loop runs all queued invocations in
+batches.
+
+Only use this if the parameters of the affected signals can be copied.
+Objects are referenced, boxed values and strings are copied, but plain
+pointers (G_TYPE_POINTER) are copied as-is.  They may no longer be valid
+by the time the callback runs.
+
+Must be called from the thread running the default main context.
+
+=cut
+void
+gperl_closure_set_async_foreign_dispatch (gboolean async)
+{
+	G_LOCK (pending_invocations_source);
+	if (async && !pending_invocations_source) {
+		static GSourceFuncs pending_invocations_funcs = {
+			pending_invocations_prepare,
+			pending_invocations_check,
+			pending_invocations_dispatch,
+			NULL,
+			NULL,
+			NULL
+		};
+		pending_invocations_source =
+			g_source_new (&pending_invocations_funcs,
+			              sizeof (GSource));
+		/* same as the idle used by _closure_hand_to_main */
+		g_source_set_priority (pending_invocations_source,
+		                       G_PRIORITY_DEFAULT_IDLE);
+		g_source_attach (pending_invocations_source, NULL);
+	}
+	G_UNLOCK (pending_invocations_source);
+
+	g_atomic_int_set (&async_foreign_dispatch, async ? TRUE : FALSE);
+}
+
 =item GClosure * gperl_closure_new (SV * callback, SV * data, gboolean swap)
 
 Create and return a new GPerlClosure.  I<callback> and I<data> will be copied
@@ -797,6 +1072,42 @@ gperl_run_exception_handlers (void)
 
 =cut
 
+#ifdef GPERL_TEST_HELPERS
+
+/* for the test suite: emit a signal from a thread that has no perl
+ * interpreter, passing it 0 .. count-1 in turn as its only parameter. */
+typedef struct {
+	GObject * object;
+	gchar   * detailed_signal;
+	gint      count;
+} ForeignEmission;
+
+/* the object may be a perl subclass, whose finalization needs perl; so the
+ * last reference must not go away in the foreign thread. */
+static gboolean
+foreign_emission_release (gpointer object)
+{
+	g_object_unref (object);
+	return FALSE;
+}
+
+static gpointer
+foreign_emission_thread (gpointer data)
+{
+	ForeignEmission * fe = data;
+	gint i;
+
+	for (i = 0 ; i < fe->count ; i++)
+		g_signal_emit_by_name (fe->object, fe->detailed_signal, i);
+
+	g_idle_add (foreign_emission_release, fe->object);
+	g_free (fe->detailed_signal);
+	g_free (fe);
+	return NULL;
+}
+
+#endif /* GPERL_TEST_HELPERS */
+
 MODULE = Glib::Closure	PACKAGE = Glib	PREFIX = gperl_
 
 =for object Glib::Signal Object customization and general purpose notification
@@ -840,6 +1151,52 @@ gperl_remove_exception_handler (class, guint tag)
     C_ARGS:
 	tag
 
+=for apidoc
+=for arg async (boolean)
+
+Callbacks invoked from threads without a perl interpreter, e.g. signals
+emitted by a streaming thread of some C library, are normally handed over
+to the main loop while the emitting thread waits for them to finish.  With
+I<$async> true, invocations that do not need a return value are queued
+instead, so that the emitting thread need not wait.  The main loop runs
+the queued callbacks in batches.  Only turn this on if the parameters of
+such signals stay valid after the emission, which is not the case for raw
+pointers.
+
+See C<gperl_closure_set_async_foreign_dispatch()> in L<Glib::xsapi>.
+
+=cut
+void
+set_async_foreign_dispatch (class, gboolean async)
+    CODE:
+	gperl_closure_set_async_foreign_dispatch (async);
+
+#ifdef GPERL_TEST_HELPERS
+
+=for apidoc __hide__
+Emits I<$detailed_signal> on I<$object> I<$count> times from a new thread
+without a perl interpreter, with an integer parameter counting up from 0.
+Returns right away.  Only built with C<perl Makefile.PL --enable-test-helpers>,
+for the test suite.
+=cut
+void
+_emit_from_foreign_thread (class, SV * object, const char * detailed_signal, gint count)
+    PREINIT:
+	ForeignEmission * fe;
+    CODE:
+	fe = g_new0 (ForeignEmission, 1);
+	fe->object = g_object_ref (gperl_get_object (object));
+	fe->detailed_signal = g_strdup (detailed_signal);
+	fe->count = count;
+#if GLIB_CHECK_VERSION (2, 32, 0)
+	g_thread_unref (g_thread_new ("gperl-foreign-emission",
+	                              foreign_emission_thread, fe));
+#else
+	g_thread_create (foreign_emission_thread, fe, FALSE, NULL);
+#endif
+
+#endif /* GPERL_TEST_HELPERS */
+
 
  ##
  ## end on the native package
@@ -148,6 +148,558 @@ gperl_child_watch_callback (GPid pid, gint status, gpointer cb)
 
 #endif /* 2.4 */
 
+#if GLIB_CHECK_VERSION (2, 28, 0)
+
+/*
+ * Glib::TimerQueue -- many perl timers on one GSource.
+ *
+ * Each Glib::Timeout->add creates a GSource of its own, and the main loop's
+ * prepare and check work grows with every one of them.  A timer queue keeps
+ * its timers in a binary heap ordered by due time, so the main loop only
+ * ever sees one source, whose timeout is that of the earliest timer, and
+ * all timers that are due are run in one dispatch.
+ *
+ * Cancelling only marks the entry, which is found through a hash by id;
+ * the heap drops marked entries when they reach the top, or all at once
+ * when more than half of the heap is dead.
+ */
+
+typedef struct {
+	guint    id;
+	gint64   due;      /* monotonic time, in microseconds */
+	gint64   interval; /* in microseconds */
+	gboolean cancelled;
+	gboolean running;
+	gboolean in_heap;
+	SV     * callback;
+	SV     * data;
+} TimerEntry;
+
+typedef struct {
+	GSource      source;
+	GPtrArray  * heap;   /* of TimerEntry, earliest due first */
+	GHashTable * by_id;  /* id -> TimerEntry, live timers only */
+	guint        last_id;
+	guint        n_cancelled;
+#ifdef PERL_IMPLICIT_CONTEXT
+	PerlInterpreter * interp;
+#endif
+} TimerQueue;
+
+#define TIMER_HEAP(q, i)	((TimerEntry *) g_ptr_array_index ((q)->heap, (i)))
+
+static gboolean
+timer_entry_before (TimerEntry * a,
+		    TimerEntry * b)
+{
+	/* ties go to the older timer */
+	return a->due < b->due || (a->due == b->due && a->id < b->id);
+}
+
+static void
+timer_entry_release (TimerEntry * entry)
+{
+	if (entry->callback) {
+		SvREFCNT_dec (entry->callback);
+		entry->callback = NULL;
+	}
+	if (entry->data) {
+		SvREFCNT_dec (entry->data);
+		entry->data = NULL;
+	}
+}
+
+static void
+timer_heap_sift_up (TimerQueue * q,
+		    guint i)
+{
+	TimerEntry * entry = TIMER_HEAP (q, i);
+	while (i > 0) {
+		guint parent = (i - 1) / 2;
+		if (!timer_entry_before (entry, TIMER_HEAP (q, parent)))
+			break;
+		q->heap->pdata[i] = q->heap->pdata[parent];
+		i = parent;
+	}
+	q->heap->pdata[i] = entry;
+}
+
+static void
+timer_heap_sift_down (TimerQueue * q,
+		      guint i)
+{
+	TimerEntry * entry = TIMER_HEAP (q, i);
+	guint n = q->heap->len;
+	while (TRUE) {
+		guint child = 2 * i + 1;
+		if (child >= n)
+			break;
+		if (child + 1 < n &&
+		    timer_entry_before (TIMER_HEAP (q, child + 1),
+					TIMER_HEAP (q, child)))
+			child++;
+		if (!timer_entry_before (TIMER_HEAP (q, child), entry))
+			break;
+		q->heap->pdata[i] = q->heap->pdata[child];
+		i = child;
+	}
+	q->heap->pdata[i] = entry;
+}
+
+static void
+timer_heap_push (TimerQueue * q,
+		 TimerEntry * entry)
+{
+	entry->in_heap = TRUE;
+	g_ptr_array_add (q->heap, entry);
+	timer_heap_sift_up (q, q->heap->len - 1);
+}
+
+static TimerEntry *
+timer_heap_pop (TimerQueue * q)
+{
+	TimerEntry * top = TIMER_HEAP (q, 0);
+	TimerEntry * last = g_ptr_array_remove_index (q->heap,
+						      q->heap->len - 1);
+	if (q->heap->len > 0) {
+		q->heap->pdata[0] = last;
+		timer_heap_sift_down (q, 0);
+	}
+	top->in_heap = FALSE;
+	return top;
+}
+
+/* the earliest live timer, if any.  cancelled entries that are not
+ * running have already given up their scalars, so they can simply be
+ * freed. */
+static TimerEntry *
+timer_queue_peek (TimerQueue * q)
+{
+	while (q->heap->len > 0 && TIMER_HEAP (q, 0)->cancelled) {
+		g_free (timer_heap_pop (q));
+		q->n_cancelled--;
+	}
+	return q->heap->len > 0 ? TIMER_HEAP (q, 0) : NULL;
+}
+
+static void
+timer_queue_compact (TimerQueue * q)
+{
+	guint i, n = 0;
+
+	for (i = 0 ; i < q->heap->len ; i++) {
+		TimerEntry * entry = TIMER_HEAP (q, i);
+		if (entry->cancelled)
+			g_free (entry);
+		else
+			q->heap->pdata[n++] = entry;
+	}
+	g_ptr_array_set_size (q->heap, n);
+	q->n_cancelled = 0;
+
+	for (i = n / 2 ; i-- > 0 ; )
+		timer_heap_sift_down (q, i);
+}
+
+static gboolean
+timer_queue_prepare (GSource * source,
+		     gint * timeout)
+{
+	TimerQueue * q = (TimerQueue *) source;
+	TimerEntry * first = timer_queue_peek (q);
+	gint64 now;
+
+	if (!first) {
+		*timeout = -1;
+		return FALSE;
+	}
+
+	now = g_source_get_time (source);
+	if (first->due <= now) {
+		*timeout = 0;
+		return TRUE;
+	}
+
+	*timeout = (gint) MIN ((first->due - now + 999) / 1000, G_MAXINT);
+	return FALSE;
+}
+
+static gboolean
+timer_queue_check (GSource * source)
+{
+	TimerQueue * q = (TimerQueue *) source;
+	TimerEntry * first = timer_queue_peek (q);
+
+	return first && first->due <= g_source_get_time (source);
+}
+
+static gboolean
+timer_queue_dispatch (GSource * source,
+		      GSourceFunc callback,
+		      gpointer user_data)
+{
+	TimerQueue * q = (TimerQueue *) source;
+	GPtrArray * expired;
+	gint64 now;
+	guint i;
+	SV * save_errsv;
+	SV ** sp;
+
+	PERL_UNUSED_VAR (callback);
+	PERL_UNUSED_VAR (user_data);
+
+	/* take everything that's due off the heap first, so that timers
+	 * (re-)added by the callbacks don't run in this round. */
+	now = g_source_get_time (source);
+	expired = g_ptr_array_new ();
+	while (timer_queue_peek (q) && TIMER_HEAP (q, 0)->due <= now)
+		g_ptr_array_add (expired, timer_heap_pop (q));
+
+#ifdef PERL_IMPLICIT_CONTEXT
+	PERL_SET_CONTEXT (q->interp);
+#endif
+	SPAGAIN;
+
+	ENTER;
+	SAVETMPS;
+
+	/* copy is needed to keep the old value alive. */
+	save_errsv = sv_2mortal (newSVsv (ERRSV));
+
+	for (i = 0 ; i < expired->len ; i++) {
+		TimerEntry * entry = g_ptr_array_index (expired, i);
+		gboolean again = FALSE;
+		int count;
+
+		/* an earlier callback in this round may have cancelled it */
+		if (!entry->cancelled) {
+			SV * ret;
+
+			entry->running = TRUE;
+
+			PUSHMARK (SP);
+			if (entry->data)
+				XPUSHs (sv_2mortal (newSVsv (entry->data)));
+			PUTBACK;
+			count = call_sv (entry->callback, G_SCALAR | G_EVAL);
+			SPAGAIN;
+			ret = count > 0 ? POPs : &PL_sv_undef;
+			PUTBACK;
+
+			if (SvTRUE (ERRSV)) {
+				gperl_run_exception_handlers ();
+				SvSetSV (ERRSV, save_errsv);
+			} else {
+				again = SvTRUE (ret);
+			}
+
+			FREETMPS;
+
+			entry->running = FALSE;
+		}
+
+		if (again && !entry->cancelled) {
+			entry->due = now + entry->interval;
+			timer_heap_push (q, entry);
+		} else {
+			if (!entry->cancelled)
+				g_hash_table_remove (q->by_id,
+						     GUINT_TO_POINTER (entry->id));
+			timer_entry_release (entry);
+			g_free (entry);
+		}
+	}
+
+	FREETMPS;
+	LEAVE;
+
+	g_ptr_array_free (expired, TRUE);
+
+	return TRUE;
+}
+
+static void
+timer_queue_finalize (GSource * source)
+{
+	TimerQueue * q = (TimerQueue *) source;
+	guint i;
+
+#ifdef PERL_IMPLICIT_CONTEXT
+	PERL_SET_CONTEXT (q->interp);
+#endif
+
+	for (i = 0 ; i < q->heap->len ; i++) {
+		timer_entry_release (TIMER_HEAP (q, i));
+		g_free (TIMER_HEAP (q, i));
+	}
+	g_ptr_array_free (q->heap, TRUE);
+	g_hash_table_destroy (q->by_id);
+}
+
+static GSourceFuncs timer_queue_funcs = {
+	timer_queue_prepare,
+	timer_queue_check,
+	timer_queue_dispatch,
+	timer_queue_finalize,
+	NULL,
+	NULL
+};
+
+static TimerQueue *
+SvTimerQueue (SV * sv)
+{
+	if (!gperl_sv_is_ref (sv) || !sv_derived_from (sv, "Glib::TimerQueue"))
+		croak ("%s is not of type Glib::TimerQueue",
+		       gperl_format_variable_for_output (sv));
+	return INT2PTR (TimerQueue *, SvIV (SvRV (sv)));
+}
+
+#endif /* 2.28 */
+
+/*
+ * Event sources implemented in perl.
+ *
+ * The perl object is a blessed hash with the GSource attached as magic, and
+ * it owns a reference to the source.  The source in turn only holds a weak
+ * reference to the perl object, so there is no cycle; the object keeping
+ * the source alive is the one the user holds.
+ *
+ * prepare, check and dispatch run on every main loop iteration, so the
+ * methods are looked up once per stash and cached in the source, stamped
+ * with perl's method cache generations like the class closure methods in
+ * GType.xs.
+ */
+
+typedef enum {
+	PERL_SOURCE_PREPARE,
+	PERL_SOURCE_CHECK,
+	PERL_SOURCE_DISPATCH,
+	PERL_SOURCE_N_METHODS
+} PerlSourceMethod;
+
+static const char * perl_source_method_names[PERL_SOURCE_N_METHODS] = {
+	"prepare",
+	"check",
+	"dispatch",
+};
+
+typedef struct {
+	GSource  source;
+	SV     * self;   /* weak reference to the perl object */
+	SV     * invocant; /* pushed for method calls; a strong reference
+	                    * only while one runs */
+	GSList * polls;  /* GPollFDs added with add_poll */
+#ifdef PERL_IMPLICIT_CONTEXT
+	PerlInterpreter * interp;
+#endif
+	/* method cache; the stash and GVs are reffed */
+	HV     * stash;
+	GV     * gvs[PERL_SOURCE_N_METHODS]; /* NULL if not defined */
+	U32      sub_generation;
+#ifdef HvMROMETA
+	U32      pkg_gen;
+	U32      cache_gen;
+#endif
+} PerlSource;
+
+static void
+perl_source_clear_methods (PerlSource * ps)
+{
+	int i;
+	for (i = 0 ; i < PERL_SOURCE_N_METHODS ; i++) {
+		if (ps->gvs[i])
+			SvREFCNT_dec (ps->gvs[i]);
+		ps->gvs[i] = NULL;
+	}
+	if (ps->stash)
+		SvREFCNT_dec (ps->stash);
+	ps->stash = NULL;
+}
+
+static CV *
+perl_source_lookup_method (PerlSource * ps,
+			   HV * stash,
+			   PerlSourceMethod which)
+{
+	int i;
+
+	if (ps->stash != stash
+	    || ps->sub_generation != PL_sub_generation
+#ifdef HvMROMETA
+	    || ps->pkg_gen != HvMROMETA (stash)->pkg_gen
+	    || ps->cache_gen != HvMROMETA (stash)->cache_gen
+#endif
+	   ) {
+		perl_source_clear_methods (ps);
+		ps->stash = (HV *) SvREFCNT_inc (stash);
+		for (i = 0 ; i < PERL_SOURCE_N_METHODS ; i++) {
+			GV * gv = gv_fetchmethod_autoload
+				(stash, perl_source_method_names[i], FALSE);
+			ps->gvs[i] = gv && GvCV (gv)
+			           ? (GV *) SvREFCNT_inc (gv)
+			           : NULL;
+		}
+		ps->sub_generation = PL_sub_generation;
+#ifdef HvMROMETA
+		ps->pkg_gen = HvMROMETA (stash)->pkg_gen;
+		ps->cache_gen = HvMROMETA (stash)->cache_gen;
+#endif
+	}
+
+	return ps->gvs[which] ? GvCV (ps->gvs[which]) : NULL;
+}
+
+/* call $self->method, if it exists.  the first return value is taken as a
+ * boolean result; if timeout is not NULL, the second one, if defined, is
+ * stored there. */
+static gboolean
+perl_source_call (PerlSource * ps,
+		  PerlSourceMethod which,
+		  gint * timeout)
+{
+	SV * object;
+	CV * cv;
+	SV * save_errsv = NULL;
+	gboolean outermost = FALSE;
+	int count;
+	gboolean ret = FALSE;
+	SV ** sp;
+
+#ifdef PERL_IMPLICIT_CONTEXT
+	PERL_SET_CONTEXT (ps->interp);
+#endif
+
+	if (!ps->self || !SvROK (ps->self))
+		return FALSE; /* the perl object is already gone */
+
+	object = SvRV (ps->self);
+	cv = perl_source_lookup_method (ps, SvSTASH (object), which);
+	if (!cv)
+		return FALSE;
+
+	/* the weak reference won't keep the object alive if the method
+	 * drops the last strong one. */
+	SvREFCNT_inc (object);
+
+	SPAGAIN;
+	ENTER;
+	SAVETMPS;
+
+	/* eval clobbers $@, so keep it if it holds anything. */
+	if (SvTRUE (ERRSV))
+		save_errsv = sv_2mortal (newSVsv (ERRSV));
+
+	/* push our own RV rather than ps->self, so that the method can't
+	 * weaken or clobber that one.  it's reset on every call; only a
+	 * recursive call (see set_can_recurse) needs a fresh one. */
+	PUSHMARK (SP);
+	if (SvROK (ps->invocant)) {
+		XPUSHs (sv_2mortal (newSVsv (ps->self)));
+	} else {
+		sv_setsv (ps->invocant, ps->self);
+		XPUSHs (ps->invocant);
+		outermost = TRUE;
+	}
+	PUTBACK;
+
+	count = call_sv ((SV *) cv, (timeout ? G_ARRAY : G_SCALAR) | G_EVAL);
+	SPAGAIN;
+
+	if (!SvTRUE (ERRSV)) {
+		SV ** rets = SP - count + 1;
+		if (count > 0)
+			ret = SvTRUE (rets[0]);
+		if (timeout && count > 1 && gperl_sv_is_defined (rets[1]))
+			*timeout = SvIV (rets[1]);
+	}
+	SP -= count;
+	PUTBACK;
+
+	if (SvTRUE (ERRSV))
+		gperl_run_exception_handlers ();
+	if (save_errsv)
+		SvSetSV (ERRSV, save_errsv);
+
+	FREETMPS;
+	LEAVE;
+
+	/* don't let the invocant keep the object alive. */
+	if (outermost)
+		sv_setsv (ps->invocant, &PL_sv_undef);
+	SvREFCNT_dec (object);
+
+	return ret;
+}
+
+static gboolean
+perl_source_prepare (GSource * source,
+		     gint * timeout)
+{
+	*timeout = -1;
+	return perl_source_call ((PerlSource *) source, PERL_SOURCE_PREPARE,
+				 timeout);
+}
+
+static gboolean
+perl_source_check (GSource * source)
+{
+	return perl_source_call ((PerlSource *) source, PERL_SOURCE_CHECK, NULL);
+}
+
+static gboolean
+perl_source_dispatch (GSource * source,
+		      GSourceFunc callback,
+		      gpointer user_data)
+{
+	PERL_UNUSED_VAR (callback);
+	PERL_UNUSED_VAR (user_data);
+	return perl_source_call ((PerlSource *) source, PERL_SOURCE_DISPATCH,
+				 NULL);
+}
+
+static void
+perl_source_finalize (GSource * source)
+{
+	PerlSource * ps = (PerlSource *) source;
+	GSList * i;
+
+	/* the perl side, including ps->self, is gone by now; see DESTROY. */
+	for (i = ps->polls ; i != NULL ; i = i->next)
+		g_free (i->data);
+	g_slist_free (ps->polls);
+}
+
+static GSourceFuncs perl_source_funcs = {
+	perl_source_prepare,
+	perl_source_check,
+	perl_source_dispatch,
+	perl_source_finalize,
+	NULL,
+	NULL
+};
+
+static PerlSource *
+SvPerlSource (SV * sv)
+{
+	MAGIC * mg;
+	if (!gperl_sv_is_ref (sv) || !sv_derived_from (sv, "Glib::Source") ||
+	    !(mg = _gperl_find_mg (SvRV (sv))))
+		croak ("%s is not a Glib::Source object",
+		       gperl_format_variable_for_output (sv));
+	return (PerlSource *) mg->mg_ptr;
+}
+
+static GPollFD *
+perl_source_find_poll (PerlSource * ps,
+		       gint fd)
+{
+	GSList * i;
+	for (i = ps->polls ; i != NULL ; i = i->next)
+		if (((GPollFD *) i->data)->fd == fd)
+			return i->data;
+	return NULL;
+}
+
 MODULE = Glib::MainLoop	PACKAGE = Glib	PREFIX = g_
 
 BOOT:
@@ -416,6 +968,280 @@ g_source_remove (class, tag)
     C_ARGS:
 	tag
 
+=for apidoc new
+=for signature source = $class->new
+
+Create a new event source whose behavior is implemented in perl.  Derive a
+package from Glib::Source and implement some of these methods in it:
+
+=over
+
+=item ($ready, $timeout) = $source->prepare
+
+Called before the main loop polls.  Return true if the source is ready to
+be dispatched right away.  Otherwise, the optional I<$timeout> is the
+maximum number of milliseconds the poll may block; -1 means forever.
+
+=item $ready = $source->check
+
+Called after the main loop has polled.  Return true if the source is ready
+to be dispatched.
+
+=item $keep = $source->dispatch
+
+Do the source's work.  Return false to have the source destroyed.
+
+=item $source->finalize
+
+Called when the perl object goes away, after the source has been destroyed.
+
+=back
+
+Missing methods count as returning false.  The source is an ordinary hash
+based object, so it may keep its state in itself.
+
+Note that the source only lives as long as the perl object does; once the
+last reference to it is gone, the source is destroyed.
+
+=cut
+SV *
+g_source_new (class)
+	const char * class
+    PREINIT:
+	GSource * source;
+	PerlSource * ps;
+	HV * hv;
+    CODE:
+	source = g_source_new (&perl_source_funcs, sizeof (PerlSource));
+	ps = (PerlSource *) source;
+#ifdef PERL_IMPLICIT_CONTEXT
+	ps->interp = aTHX;
+#endif
+	hv = newHV ();
+	/* the hash owns the initial reference on the source */
+	_gperl_attach_mg ((SV *) hv, source);
+	RETVAL = newRV_noinc ((SV *) hv);
+	sv_bless (RETVAL, gv_stashpv (class, TRUE));
+	ps->self = newRV_inc ((SV *) hv);
+	sv_rvweaken (ps->self);
+	ps->invocant = newSV (0);
+    OUTPUT:
+	RETVAL
+
+void
+DESTROY (sv)
+	SV * sv
+    PREINIT:
+	PerlSource * ps;
+	MAGIC * mg;
+	GV * gv;
+    CODE:
+	if (!gperl_sv_is_ref (sv) || !(mg = _gperl_find_mg (SvRV (sv))))
+		return;
+	ps = (PerlSource *) mg->mg_ptr;
+	g_source_destroy ((GSource *) ps);
+	gv = gv_fetchmethod_autoload (SvSTASH (SvRV (sv)), "finalize", FALSE);
+	if (gv && GvCV (gv)) {
+		PUSHMARK (SP);
+		XPUSHs (sv);
+		PUTBACK;
+		/* the cleanup below has to happen even if finalize dies. */
+		call_sv ((SV *) GvCV (gv), G_VOID | G_DISCARD | G_EVAL);
+		SPAGAIN;
+		if (SvTRUE (ERRSV))
+			gperl_run_exception_handlers ();
+	}
+	_gperl_remove_mg (SvRV (sv));
+	perl_source_clear_methods (ps);
+	SvREFCNT_dec (ps->self);
+	ps->self = NULL;
+	SvREFCNT_dec (ps->invocant);
+	ps->invocant = NULL;
+	g_source_unref ((GSource *) ps);
+
+=for apidoc
+=for arg context (Glib::MainContext) or undef for the default context
+
+Attach the source to I<$context> and return its id, which may be used with
+C<< Glib::Source->remove >>.
+
+=cut
+guint
+g_source_attach (source, context=NULL)
+	SV * source
+	GMainContext * context
+    C_ARGS:
+	(GSource *) SvPerlSource (source), context
+
+=for apidoc
+Remove the source from its context; it will not be dispatched anymore.
+=cut
+void
+g_source_destroy (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+guint
+g_source_get_id (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+void
+g_source_set_priority (source, gint priority)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), priority
+
+gint
+g_source_get_priority (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+void
+g_source_set_can_recurse (source, gboolean can_recurse)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), can_recurse
+
+gboolean
+g_source_get_can_recurse (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+#if GLIB_CHECK_VERSION (2, 12, 0)
+
+gboolean
+g_source_is_destroyed (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+#endif
+
+#if GLIB_CHECK_VERSION (2, 28, 0)
+
+=for apidoc
+Returns the time of the current main loop iteration, in microseconds of
+the monotonic clock.
+=cut
+gint64
+g_source_get_time (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+#endif
+
+=for apidoc
+=for arg events (Glib::IOCondition)
+
+Have the main loop poll the file descriptor I<$fd> for I<$events> on
+behalf of this source.  The result is available through
+C<get_poll_revents> in C<check> and C<dispatch>.
+
+=cut
+void
+add_poll (source, gint fd, GIOCondition events)
+	SV * source
+    PREINIT:
+	PerlSource * ps;
+	GPollFD * poll_fd;
+    CODE:
+	ps = SvPerlSource (source);
+	if (perl_source_find_poll (ps, fd))
+		croak ("file descriptor %d is already being polled", fd);
+	poll_fd = g_new0 (GPollFD, 1);
+	poll_fd->fd = fd;
+	poll_fd->events = events;
+	ps->polls = g_slist_prepend (ps->polls, poll_fd);
+	g_source_add_poll ((GSource *) ps, poll_fd);
+
+void
+remove_poll (source, gint fd)
+	SV * source
+    PREINIT:
+	PerlSource * ps;
+	GPollFD * poll_fd;
+    CODE:
+	ps = SvPerlSource (source);
+	poll_fd = perl_source_find_poll (ps, fd);
+	if (poll_fd) {
+		g_source_remove_poll ((GSource *) ps, poll_fd);
+		ps->polls = g_slist_remove (ps->polls, poll_fd);
+		g_free (poll_fd);
+	}
+
+GIOCondition
+get_poll_revents (source, gint fd)
+	SV * source
+    PREINIT:
+	GPollFD * poll_fd;
+    CODE:
+	poll_fd = perl_source_find_poll (SvPerlSource (source), fd);
+	if (!poll_fd)
+		croak ("file descriptor %d is not being polled", fd);
+	RETVAL = poll_fd->revents;
+    OUTPUT:
+	RETVAL
+
+#if GLIB_CHECK_VERSION (2, 36, 0)
+
+=for apidoc
+Have the source dispatched once the monotonic clock (see C<get_time>)
+reaches I<$ready_time>, in microseconds.  -1 turns this off, 0 means now.
+=cut
+void
+g_source_set_ready_time (source, gint64 ready_time)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), ready_time
+
+gint64
+g_source_get_ready_time (source)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source)
+
+=for apidoc
+=for arg events (Glib::IOCondition)
+
+Like C<add_poll>, but managed by GLib.  Returns a tag for use with
+C<modify_unix_fd>, C<query_unix_fd> and C<remove_unix_fd>.
+
+=cut
+IV
+g_source_add_unix_fd (source, gint fd, GIOCondition events)
+	SV * source
+    CODE:
+	RETVAL = PTR2IV (g_source_add_unix_fd ((GSource *) SvPerlSource (source),
+	                                       fd, events));
+    OUTPUT:
+	RETVAL
+
+void
+g_source_modify_unix_fd (source, IV tag, GIOCondition new_events)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), INT2PTR (gpointer, tag), new_events
+
+void
+g_source_remove_unix_fd (source, IV tag)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), INT2PTR (gpointer, tag)
+
+GIOCondition
+g_source_query_unix_fd (source, IV tag)
+	SV * source
+    C_ARGS:
+	(GSource *) SvPerlSource (source), INT2PTR (gpointer, tag)
+
+#endif
+
  ##gboolean g_source_remove_by_user_data        (gpointer       user_data);
  ##gboolean g_source_remove_by_funcs_user_data  (GSourceFuncs  *funcs,
  ##					      gpointer       user_data);
@@ -616,3 +1442,138 @@ g_child_watch_add (class, int pid, SV *callback, SV *data=NULL, gint priority=G_
 	RETVAL
 
 #endif /* 2.4 */
+
+
+#if GLIB_CHECK_VERSION (2, 28, 0)
+
+MODULE = Glib::MainLoop	PACKAGE = Glib::TimerQueue	PREFIX = timer_queue_
+
+=for object Glib::MainLoop
+=cut
+
+=for apidoc
+=for signature queue = Glib::TimerQueue->new ($priority=G_PRIORITY_DEFAULT)
+
+Create a queue for many timers which share a single event source of the
+given I<$priority> in the default main context.  This is a better fit than
+one C<< Glib::Timeout->add >> per timer when there are thousands of them:
+the main loop only has to look at the earliest one, and all timers which
+are due at the same time are run in a single go.
+
+The timers stop when the queue is destroyed, i.e. when the last reference
+to it goes away.
+
+=cut
+SV *
+timer_queue_new (class, gint priority=G_PRIORITY_DEFAULT)
+	const char * class
+    PREINIT:
+	GSource * source;
+	TimerQueue * q;
+    CODE:
+	source = g_source_new (&timer_queue_funcs, sizeof (TimerQueue));
+	q = (TimerQueue *) source;
+	q->heap = g_ptr_array_new ();
+	q->by_id = g_hash_table_new (g_direct_hash, g_direct_equal);
+#ifdef PERL_IMPLICIT_CONTEXT
+	q->interp = aTHX;
+#endif
+	if (priority != G_PRIORITY_DEFAULT)
+		g_source_set_priority (source, priority);
+	g_source_attach (source, NULL);
+	/* the perl object owns the initial reference */
+	RETVAL = sv_setref_pv (newSV (0), class, source);
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+=for arg interval number of milliseconds
+=for arg callback (subroutine)
+
+Run I<$callback> with I<$data> every I<$interval> milliseconds until it
+returns false, just like C<< Glib::Timeout->add >>.  Returns an id which
+may be passed to C<remove>.
+
+=cut
+guint
+timer_queue_add (queue, guint interval, SV * callback, SV * data=NULL)
+	SV * queue
+    PREINIT:
+	TimerQueue * q;
+	TimerEntry * entry;
+    CODE:
+	q = SvTimerQueue (queue);
+	entry = g_new0 (TimerEntry, 1);
+	do {
+		entry->id = ++q->last_id;
+	} while (entry->id == 0 ||
+		 g_hash_table_lookup (q->by_id, GUINT_TO_POINTER (entry->id)));
+	entry->interval = (gint64) interval * 1000;
+	entry->due = g_get_monotonic_time () + entry->interval;
+	entry->callback = newSVsv (callback);
+	entry->data = gperl_sv_is_defined (data) ? newSVsv (data) : NULL;
+	g_hash_table_insert (q->by_id, GUINT_TO_POINTER (entry->id), entry);
+	timer_heap_push (q, entry);
+	RETVAL = entry->id;
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+
+Cancel the timer with id I<$id>.  Returns false if there is no such timer,
+e.g. because its callback returned false already.
+
+=cut
+gboolean
+timer_queue_remove (queue, guint id)
+	SV * queue
+    PREINIT:
+	TimerQueue * q;
+	TimerEntry * entry;
+    CODE:
+	q = SvTimerQueue (queue);
+	entry = g_hash_table_lookup (q->by_id, GUINT_TO_POINTER (id));
+	RETVAL = entry != NULL;
+	if (entry) {
+		g_hash_table_remove (q->by_id, GUINT_TO_POINTER (id));
+		entry->cancelled = TRUE;
+		/* a running callback is still using its scalars; the
+		 * dispatcher will release them. */
+		if (!entry->running)
+			timer_entry_release (entry);
+		/* entries taken off the heap for dispatch are freed by the
+		 * dispatcher, all others when they leave the heap. */
+		if (entry->in_heap) {
+			q->n_cancelled++;
+			if (q->n_cancelled > 64 &&
+			    q->n_cancelled > q->heap->len / 2)
+				timer_queue_compact (q);
+		}
+	}
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+
+Returns the number of timers in the queue.
+
+=cut
+guint
+timer_queue_count (queue)
+	SV * queue
+    CODE:
+	RETVAL = g_hash_table_size (SvTimerQueue (queue)->by_id);
+    OUTPUT:
+	RETVAL
+
+void
+timer_queue_DESTROY (queue)
+	SV * queue
+    PREINIT:
+	GSource * source;
+    CODE:
+	source = (GSource *) SvTimerQueue (queue);
+	g_source_destroy (source);
+	g_source_unref (source);
+
+#endif /* 2.28 */
@@ -52,8 +52,9 @@ Propers go to Marc Lehmann for dreaming most of this up.
 =cut
 
 #include "gperl.h"
-#include "gperl-private.h" /* for GPERL_SET_CONTEXT and
-	                    * _gperl_sv_from_value_internal */
+#include "gperl-private.h" /* for GPERL_SET_CONTEXT,
+	                    * _gperl_sv_from_value_internal and
+	                    * GPerlValueConverter */
 
 typedef struct _ClassInfo ClassInfo;
 typedef struct _SinkFunc  SinkFunc;
@@ -61,7 +62,9 @@ typedef struct _SinkFunc  SinkFunc;
 struct _ClassInfo {
 	GType   gtype;
 	char  * package;
-	gboolean initialized;
+	gint    initialized; /* accessed with g_atomic_int_* */
+	HV    * stash; /* cached for the master interpreter only; accessed
+	                * with g_atomic_pointer_* */
 };
 
 struct _SinkFunc {
@@ -72,6 +75,11 @@ struct _SinkFunc {
 static GHashTable * types_by_type    = NULL;
 static GHashTable * types_by_package = NULL;
 
+/* ClassInfos replaced by a later registration; they might still be
+ * referenced from the qdata cache or types_by_package.  protected by the
+ * types_by_type lock. */
+static GSList * retired_class_infos = NULL;
+
 /* store outside of the class info maps any options we expect to be sparse;
  * this will save us a fair amount of space. */
 static GHashTable * nowarn_by_type = NULL;
@@ -79,14 +87,73 @@ static GArray     * sink_funcs     = NULL;
 
 static GQuark wrapper_quark; /* this quark stores the object's wrapper sv */
 
+/* each registered GType also carries a pointer to its ClassInfo in its qdata,
+ * so that the hot type -> package/stash lookups need not take the
+ * types_by_type lock.  the qdata is only ever set with types_by_type held.
+ * since readers may still hold a ClassInfo after it has been replaced by a
+ * later registration, replaced infos are never freed. */
+static GQuark
+class_info_quark (void)
+{
+	static GQuark q = 0;
+	if (!q)
+		q = g_quark_from_static_string ("GPerlClassInfo");
+	return q;
+}
+
 /* what should be done here */
 #define GPERL_THREAD_SAFE !GPERL_DISABLE_THREADSAFE
 
 #if GPERL_THREAD_SAFE
-/* keep a list of all gobjects */
-static gboolean     perl_gobject_tracking = FALSE;
-static GHashTable * perl_gobjects = NULL;
+/* keep a list of all gobjects, mapping each to the number of interpreters
+ * holding a wrapper for it.  the list is split into shards, each with its
+ * own lock, so that threads wrapping and destroying different objects
+ * rarely contend with each other.  the perl_gobjects lock only guards
+ * setting up the shards. */
+#define PERL_GOBJECTS_N_SHARDS 16
+typedef struct {
+#if GLIB_CHECK_VERSION (2, 32, 0)
+	GMutex       lock;
+#else
+	GStaticMutex lock;
+#endif
+	GHashTable * objects;
+} PerlGObjectShard;
+
+static gboolean         perl_gobject_tracking = FALSE;
+static PerlGObjectShard perl_gobjects[PERL_GOBJECTS_N_SHARDS];
 G_LOCK_DEFINE_STATIC (perl_gobjects);
+
+#define PERL_GOBJECTS_SHARD(object) \
+	(&perl_gobjects[((((gsize) (object)) >> 4) ^ (((gsize) (object)) >> 10)) \
+	                & (PERL_GOBJECTS_N_SHARDS - 1)])
+#if GLIB_CHECK_VERSION (2, 32, 0)
+# define PERL_GOBJECTS_SHARD_LOCK(shard)   g_mutex_lock (&(shard)->lock)
+# define PERL_GOBJECTS_SHARD_UNLOCK(shard) g_mutex_unlock (&(shard)->lock)
+#else
+# define PERL_GOBJECTS_SHARD_LOCK(shard)   g_static_mutex_lock (&(shard)->lock)
+# define PERL_GOBJECTS_SHARD_UNLOCK(shard) g_static_mutex_unlock (&(shard)->lock)
+#endif
+
+static void
+perl_gobjects_init (void)
+{
+	static gboolean initialized = FALSE;
+
+	G_LOCK (perl_gobjects);
+	if (!initialized) {
+		int i;
+		for (i = 0 ; i < PERL_GOBJECTS_N_SHARDS ; i++) {
+#if !GLIB_CHECK_VERSION (2, 32, 0)
+			g_static_mutex_init (&perl_gobjects[i].lock);
+#endif
+			perl_gobjects[i].objects =
+				g_hash_table_new (g_direct_hash, g_direct_equal);
+		}
+		initialized = TRUE;
+	}
+	G_UNLOCK (perl_gobjects);
+}
 #endif
 
 /* thread safety locks for the modifiables above */
@@ -98,6 +165,11 @@ G_LOCK_DEFINE_STATIC (sink_funcs);
 
 static MGVTBL gperl_mg_vtbl;
 
+/* _gperl_attach_mg is shared with other wrapper types (GKeyFile, GParamSpec,
+ * ...), so object wrappers additionally tag their magic with this value in
+ * mg_private.  only tagged magic is known to point at a GObject. */
+#define GPERL_OBJECT_MG_PRIVATE 0x474f /* "GO" */
+
 /*
  * Attach a C<ptr> to the given C<sv>. It can be retrieved later using
  * C<_gperl_find_mg> and removed again using C<_gperl_remove_mg>.
@@ -183,6 +255,7 @@ class_info_new (GType gtype,
 	class_info->gtype = gtype;
 	class_info->package = g_strdup (package);
 	class_info->initialized = FALSE;
+	class_info->stash = NULL;
 
 	return class_info;
 }
@@ -316,7 +389,7 @@ class_info_finish_loading (ClassInfo * class_info)
 	av_clear (new_isa);
 	av_undef (new_isa);
 
-	class_info->initialized = TRUE;
+	g_atomic_int_set (&class_info->initialized, TRUE);
 
 #ifdef NOISY
 	warn ("%sdone\n", leader);
@@ -385,6 +458,7 @@ gperl_register_object (GType gtype,
                        const char * package)
 {
 	ClassInfo * class_info;
+	ClassInfo * old_class_info;
 
 	G_LOCK (types_by_type);
 	G_LOCK (types_by_package);
@@ -407,16 +481,21 @@ gperl_register_object (GType gtype,
 	}
 	class_info = class_info_new (gtype, package);
 
-	/* We need to insert into types_by_package first because there might
-	 * otherwise be trouble if we overwrite an entry: inserting into
-	 * types_by_type frees the class_info of the overwritten entry, so
-	 * that class_info->package is no longer valid at this point.
-	 *
-	 * Note also it's g_hash_table_replace() for types_by_package,
-	 * because the old key string in the old class_info will be freed
-	 * when types_by_type updates the value there.
-	 */
+	/* an info replaced by this registration may still be in use by
+	 * lock-free readers of the qdata, so retire it instead of letting
+	 * types_by_type destroy it. */
+	old_class_info = (ClassInfo *)
+		g_hash_table_lookup (types_by_type, (gpointer) gtype);
+	if (old_class_info) {
+		g_hash_table_steal (types_by_type, (gpointer) gtype);
+		retired_class_infos = g_slist_prepend (retired_class_infos,
+		                                       old_class_info);
+	}
+
+	/* Note it's g_hash_table_replace() for types_by_package, so that the
+	 * key is the new class_info's own copy of the package name. */
 	g_hash_table_replace (types_by_package, class_info->package, class_info);
+	g_type_set_qdata (gtype, class_info_quark (), class_info);
 	g_hash_table_insert (types_by_type,
 	                     (gpointer) class_info->gtype, class_info);
 	/* warn ("registered type %s to package %s\n", g_type_name (class_info->gtype), class_info->package); */
@@ -674,6 +753,11 @@ gperl_object_package_from_type (GType gtype)
 {
 	ClassInfo * class_info;
 
+	/* fast path: registered and fully loaded. */
+	class_info = (ClassInfo *) g_type_get_qdata (gtype, class_info_quark ());
+	if (class_info && g_atomic_int_get (&class_info->initialized))
+		return class_info->package;
+
 	if (!g_type_is_a (gtype, G_TYPE_OBJECT) &&
 	    !g_type_is_a (gtype, G_TYPE_INTERFACE))
 		return NULL;
@@ -725,7 +809,7 @@ gperl_object_package_from_type (GType gtype)
 
 	g_assert (class_info);
 
-	if (!class_info->initialized) {
+	if (!g_atomic_int_get (&class_info->initialized)) {
 		/* do a proper @ISA setup for this guy. */
 		class_info_finish_loading (class_info);
 	}
@@ -744,11 +828,38 @@ not registered.  The stash is useful for C<bless>ing.
 HV *
 gperl_object_stash_from_type (GType gtype)
 {
-	const char * package = gperl_object_package_from_type (gtype);
-	if (package)
-		return gv_stashpv (package, TRUE);
-	else
+	ClassInfo * class_info;
+	const char * package;
+	HV * stash;
+
+	/* stashes belong to an interpreter, so only the master interpreter's
+	 * stash is cached; other interpreters (ithreads) look theirs up. */
+	class_info = (ClassInfo *) g_type_get_qdata (gtype, class_info_quark ());
+	if (class_info
+	    && NULL != (stash = (HV *) g_atomic_pointer_get (&class_info->stash))
+#ifdef PERL_IMPLICIT_CONTEXT
+	    && aTHX == _gperl_get_master_interp ()
+#endif
+	   )
+		return stash;
+
+	package = gperl_object_package_from_type (gtype);
+	if (!package)
 		return NULL;
+
+	class_info = (ClassInfo *) g_type_get_qdata (gtype, class_info_quark ());
+	if (class_info && g_atomic_int_get (&class_info->initialized)
+	    && class_info->package == package
+#ifdef PERL_IMPLICIT_CONTEXT
+	    && aTHX == _gperl_get_master_interp ()
+#endif
+	   ) {
+		stash = gv_stashpv (package, TRUE);
+		g_atomic_pointer_set (&class_info->stash, stash);
+		return stash;
+	}
+
+	return gv_stashpv (package, TRUE);
 }
 
 
@@ -906,12 +1017,22 @@ gperl_new_object (GObject * object,
                  * This does not need to be a HV, the only problem is finding
                  * out what to use, and HV is certainly the way to go for any
                  * built-in objects.
+                 *
+                 * It is also about as small as a wrapper can be: a scalar
+                 * that can carry magic and a stash has to be a PVMG, whose
+                 * body is no smaller than an HV's, and perl allocates an
+                 * HV's bucket array only when the first key is stored.  So
+                 * a wrapper whose hash is never used costs the SV head and
+                 * body plus our magic, and nothing else, as long as nobody
+                 * stores into it -- see _gperl_fetch_wrapper_key, which
+                 * takes care not to.
                  */
 
                 /* this increases the combined object's refcount. */
                 obj = (SV *)newHV ();
                 /* attach magic */
                 _gperl_attach_mg (obj, object);
+                _gperl_find_mg (obj)->mg_private = GPERL_OBJECT_MG_PRIVATE;
 
                 /* The SV has a ref to the C object.  If we are to own this
                  * object, then any other references will be taken care of
@@ -972,12 +1093,11 @@ gperl_new_object (GObject * object,
 #if GPERL_THREAD_SAFE
 	if(perl_gobject_tracking)
 	{
-		G_LOCK (perl_gobjects);
+		PerlGObjectShard * shard = PERL_GOBJECTS_SHARD (object);
+		PERL_GOBJECTS_SHARD_LOCK (shard);
 /*g_printerr ("adding object: 0x%p - %d\n", object, object->ref_count);*/
-		if (!perl_gobjects)
-			perl_gobjects = g_hash_table_new (g_direct_hash, g_direct_equal);
-		g_hash_table_insert (perl_gobjects, (gpointer)object, (gpointer)1);
-		G_UNLOCK (perl_gobjects);
+		g_hash_table_insert (shard->objects, (gpointer)object, (gpointer)1);
+		PERL_GOBJECTS_SHARD_UNLOCK (shard);
 	}
 #endif
 
@@ -1014,6 +1134,9 @@ croaks if I<sv> is undef or is not blessed into the package corresponding
 to I<gtype>.  use this for bringing parameters into xsubs from perl.
 Returns the same as gperl_get_object() (provided it doesn't croak first).
 
+If the GObject attached to I<sv> is an instance of I<gtype>, the check is
+done on the GType alone; @ISA is only consulted when that fails.
+
 =cut
 
 GObject *
@@ -1022,6 +1145,16 @@ gperl_get_object_check (SV * sv,
 {
 	MAGIC *mg;
 	const char * package;
+
+	/* the magic tells us what the object really is; if its GType
+	 * satisfies the request we can skip walking @ISA by name.  only
+	 * things like reblessed wrappers have to take the long way. */
+	if (gperl_sv_is_ref (sv) &&
+	    (mg = _gperl_find_mg (SvRV (sv))) &&
+	    mg->mg_private == GPERL_OBJECT_MG_PRIVATE &&
+	    g_type_is_a (G_OBJECT_TYPE ((GObject *) mg->mg_ptr), gtype))
+		return (GObject *) mg->mg_ptr;
+
 	package = gperl_object_package_from_type (gtype);
 	if (!package)
 		croak ("INTERNAL: GType %s (%lu) is not registered with GPerl!",
@@ -1057,26 +1190,311 @@ gperl_object_check_type (SV * sv,
 
 
 
-/* helper for g_object_[gs]et_parameter */
+/*
+ * new, get and set resolve property names over and over again, usually
+ * the same handful for a given class.  the first time a class is used, we
+ * build a table of all its properties under both the '-' and the '_'
+ * spelling, hashed with perl's hash function so that a name SV which is a
+ * shared hash key (e.g. one that came out of a hash) doesn't even need to
+ * be hashed again.  the table is immutable once it is attached to the type,
+ * so lookups take no lock; it is never freed.  names that aren't in it
+ * (properties installed after the table was built, say) fall back to
+ * g_object_class_find_property().
+ */
+typedef struct {
+	U32          hash;
+	STRLEN       len;
+	char       * name;
+	GParamSpec * pspec;
+} PropertyTableEntry;
+
+typedef struct {
+	guint                mask;
+	PropertyTableEntry * entries;
+} PropertyTable;
+
+G_LOCK_DEFINE_STATIC (property_tables);
+
+static void
+property_table_insert (PropertyTable * table,
+		       const char * name,
+		       GParamSpec * pspec)
+{
+	STRLEN len = strlen (name);
+	U32 hash;
+	guint i;
+
+	PERL_HASH (hash, name, len);
+	for (i = hash & table->mask ;
+	     table->entries[i].name ;
+	     i = (i + 1) & table->mask)
+		;
+	table->entries[i].hash = hash;
+	table->entries[i].len = len;
+	table->entries[i].name = g_strdup (name);
+	table->entries[i].pspec = g_param_spec_ref (pspec);
+}
+
+static PropertyTable *
+property_table_get (GObjectClass * oclass)
+{
+	static GQuark quark_property_table = 0;
+	GType type = G_OBJECT_CLASS_TYPE (oclass);
+	PropertyTable * table;
+	GParamSpec ** props;
+	guint n_props, size, i;
+
+	if (quark_property_table) {
+		table = g_type_get_qdata (type, quark_property_table);
+		if (table)
+			return table;
+	}
+
+	G_LOCK (property_tables);
+
+	if (!quark_property_table)
+		quark_property_table = g_quark_from_static_string
+						("GPerlPropertyTable");
+	table = g_type_get_qdata (type, quark_property_table);
+	if (!table) {
+		props = g_object_class_list_properties (oclass, &n_props);
+		/* two spellings per property, at most half full */
+		for (size = 8 ; size < 4 * n_props ; size <<= 1)
+			;
+		table = g_new (PropertyTable, 1);
+		table->mask = size - 1;
+		table->entries = g_new0 (PropertyTableEntry, size);
+		for (i = 0 ; i < n_props ; i++) {
+			const char * name = g_param_spec_get_name (props[i]);
+			property_table_insert (table, name, props[i]);
+			if (strchr (name, '-')) {
+				char * munged = g_strdelimit (g_strdup (name),
+							      "-", '_');
+				property_table_insert (table, munged, props[i]);
+				g_free (munged);
+			}
+		}
+		g_free (props);
+		g_type_set_qdata (type, quark_property_table, table);
+	}
+
+	G_UNLOCK (property_tables);
+
+	return table;
+}
+
+static GParamSpec *
+find_property_sv (GObjectClass * oclass,
+		  SV * name_sv)
+{
+	PropertyTable * table = property_table_get (oclass);
+	const char * name;
+	STRLEN len;
+	U32 hash;
+	guint i;
+
+	name = SvPV (name_sv, len);
+#ifdef SvIsCOW_shared_hash
+	if (SvIsCOW_shared_hash (name_sv))
+		hash = SvSHARED_HASH (name_sv);
+	else
+#endif
+		PERL_HASH (hash, name, len);
+
+	for (i = hash & table->mask ;
+	     table->entries[i].name ;
+	     i = (i + 1) & table->mask)
+	{
+		PropertyTableEntry * entry = &table->entries[i];
+		if (entry->hash == hash && entry->len == len &&
+		    memcmp (entry->name, name, len) == 0)
+			return entry->pspec;
+	}
+
+	return g_object_class_find_property (oclass, name);
+}
+
 static void
-init_property_value (GObject * object,
-		     const char * name,
-		     GValue * value)
+croak_unknown_property (GType type,
+			SV * name_sv)
 {
-	GParamSpec * pspec;
-	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (object),
-	                                      name);
-	if (!pspec) {
-		const char * classname =
-			gperl_object_package_from_type (G_OBJECT_TYPE (object));
-		if (!classname)
-			classname = G_OBJECT_TYPE_NAME (object);
-		croak ("type %s does not support property '%s'",
-		       classname, name);
+	const char * classname = gperl_object_package_from_type (type);
+	if (!classname)
+		classname = g_type_name (type);
+	croak ("type %s does not support property '%s'",
+	       classname, SvPV_nolen (name_sv));
+}
+
+/* names and values for new and set.  the batch itself lives on the C stack,
+ * as do its arrays unless there are many properties.  the values are unset
+ * (and any arrays freed) at the next LEAVE -- also when converting a value
+ * croaks. */
+#define PROPERTY_BATCH_PREALLOC 8
+typedef struct {
+	guint          n;
+	const char  ** names;
+	GValue       * values;
+	const char   * names_buf[PROPERTY_BATCH_PREALLOC];
+	GValue         values_buf[PROPERTY_BATCH_PREALLOC];
+} PropertyBatch;
+
+static void
+property_batch_clear (pTHX_ void * data)
+{
+	PropertyBatch * batch = data;
+	guint i;
+	for (i = 0 ; i < batch->n ; i++)
+		if (G_IS_VALUE (&batch->values[i]))
+			g_value_unset (&batch->values[i]);
+	if (batch->values != batch->values_buf) {
+		g_free (batch->names);
+		g_free (batch->values);
 	}
-	g_value_init (value, G_PARAM_SPEC_VALUE_TYPE (pspec));
 }
 
+static void
+property_batch_init (pTHX_ PropertyBatch * batch, guint n)
+{
+	batch->n = n;
+	if (n <= PROPERTY_BATCH_PREALLOC) {
+		batch->names = batch->names_buf;
+		batch->values = batch->values_buf;
+		memset (batch->values, 0, n * sizeof (GValue));
+	} else {
+		batch->names = g_new0 (const char *, n);
+		batch->values = g_new0 (GValue, n);
+	}
+	SAVEDESTRUCTOR_X (property_batch_clear, batch);
+}
+
+static void
+type_class_release (pTHX_ void * oclass)
+{
+	PERL_UNUSED_CONTEXT;
+	g_type_class_unref (oclass);
+}
+
+/*
+ * per-property accessor xsubs, installed by
+ * Glib::Object::install_property_accessors.  the GParamSpec and the value
+ * converter are bound to the CV when it is created.  getters call the
+ * owning class' get_property directly, as g_object_get_property would after
+ * looking up the name; setters still go through g_object_set_property,
+ * which looks the name up again, because it also takes care of validation
+ * and change notification.
+ */
+typedef struct {
+	GParamSpec                * pspec;
+	GObjectClass              * owner_class; /* reffed */
+	GParamSpec                * get_pspec;   /* the redirect target, if any */
+	const GPerlValueConverter * converter;
+} PropertyAccessor;
+
+/* the accessor is attached to its CV as magic, so that it goes away with
+ * the CV when the method is redefined or the package is deleted. */
+static int
+property_accessor_free (pTHX_ SV * sv, MAGIC * mg)
+{
+	PropertyAccessor * accessor = (PropertyAccessor *) mg->mg_ptr;
+	PERL_UNUSED_VAR (sv);
+	g_type_class_unref (accessor->owner_class);
+	g_param_spec_unref (accessor->pspec);
+	g_free (accessor);
+	return 0;
+}
+
+static MGVTBL property_accessor_vtbl = { 0, 0, 0, 0, property_accessor_free };
+
+static void
+gperl_object_property_getter (pTHX_ CV * cv)
+{
+	dXSARGS;
+	PropertyAccessor * accessor = (PropertyAccessor *) XSANY.any_ptr;
+	GParamSpec * pspec = accessor->pspec;
+	GObject * object;
+	GValue value = {0,};
+
+	if (items != 1)
+		croak ("Usage: $object->get_%s ()", pspec->name);
+
+	object = gperl_get_object_check (ST (0), pspec->owner_type);
+	g_value_init (&value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+	g_object_ref (object);
+	accessor->owner_class->get_property (object, pspec->param_id, &value,
+	                                     accessor->get_pspec);
+	g_object_unref (object);
+	ST (0) = sv_2mortal (_gperl_converter_sv_from_value
+				(accessor->converter, &value, TRUE));
+	g_value_unset (&value);
+	XSRETURN (1);
+}
+
+static void
+gperl_object_property_setter (pTHX_ CV * cv)
+{
+	dXSARGS;
+	PropertyAccessor * accessor = (PropertyAccessor *) XSANY.any_ptr;
+	GParamSpec * pspec = accessor->pspec;
+	GObject * object;
+	GValue value = {0,};
+
+	if (items != 2)
+		croak ("Usage: $object->set_%s ($value)", pspec->name);
+
+	object = gperl_get_object_check (ST (0), pspec->owner_type);
+	g_value_init (&value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+	_gperl_converter_value_from_sv (accessor->converter, &value, ST (1));
+	g_object_set_property (object, pspec->name, &value);
+	g_value_unset (&value);
+	XSRETURN_EMPTY;
+}
+
+/* returns TRUE if a new xsub was installed */
+static gboolean
+install_property_accessor (const char * package,
+			   const char * prefix,
+			   GParamSpec * pspec,
+			   XSUBADDR_t xsub,
+			   SV * method)
+{
+	PropertyAccessor * accessor;
+	GParamSpec * redirect;
+	char * fullname;
+	CV * cv;
+
+	sv_setpvf (method, "%s_%s", prefix, pspec->name);
+	g_strdelimit (SvPVX (method), "-", '_');
+	fullname = g_strconcat (package, "::", SvPVX (method), NULL);
+
+	if (get_cv (fullname, 0)) {
+		/* never clobber existing methods; bindings frequently have
+		 * hand-written ones with the same name. */
+		g_free (fullname);
+		return FALSE;
+	}
+
+	accessor = g_new (PropertyAccessor, 1);
+	accessor->pspec = g_param_spec_ref (pspec);
+	accessor->owner_class = g_type_class_ref (pspec->owner_type);
+	/* overridden (e.g. interface) properties are implemented with the
+	 * overriding pspec's id, but get the original pspec. */
+#if GLIB_CHECK_VERSION (2, 4, 0)
+	redirect = g_param_spec_get_redirect_target (pspec);
+#else
+	redirect = NULL;
+#endif
+	accessor->get_pspec = redirect ? redirect : pspec;
+	accessor->converter = _gperl_value_converter_lookup
+					(G_PARAM_SPEC_VALUE_TYPE (pspec));
+
+	cv = newXS (fullname, xsub, __FILE__);
+	CvXSUBANY (cv).any_ptr = accessor;
+	sv_magicext ((SV *) cv, NULL, PERL_MAGIC_ext, &property_accessor_vtbl,
+	             (const char *) accessor, 0);
+	g_free (fullname);
+
+	return TRUE;
+}
 
 =item typedef GObject GObject_noinc
 
@@ -1103,6 +1521,11 @@ init_property_value (GObject * object,
  *
  * if create is true, autovivify the key (and always return a value).
  * if create is false, returns NULL is there is no such key.
+ *
+ * lookups of keys that don't exist must not store anything into the hash,
+ * so that wrappers of objects whose perl side never stores keys don't get
+ * a bucket array allocated for them.  the name is only copied if it has
+ * dashes to convert.
  */
 SV *
 _gperl_fetch_wrapper_key (GObject * object,
@@ -1110,42 +1533,40 @@ _gperl_fetch_wrapper_key (GObject * object,
                           gboolean create)
 {
 	SV ** svp;
-	SV * svname;
 	HV * wrapper_hash;
+	I32 len = strlen (name);
+	const char * dash;
+
 	wrapper_hash = g_object_get_qdata (object, wrapper_quark);
 
 	/* we don't care whether the wrapper is alive or undead.  forcibly
 	 * remove the undead bit, or the pointer will be unusable. */
 	wrapper_hash = REVIVE_UNDEAD (wrapper_hash);
 
-	svname = newSVpv (name, strlen (name));
-	svp = hv_fetch (wrapper_hash, SvPV_nolen (svname), SvCUR (svname),
-	                FALSE); /* never create on the first try; prefer
-	                         * prefer to create the second version. */
-	if (!svp) {
+	dash = memchr (name, '-', len);
+	svp = hv_fetch (wrapper_hash, name, len,
+	                dash ? FALSE : create); /* if there are dashes, never
+	                                         * create on the first try;
+	                                         * prefer to create the second
+	                                         * version. */
+	if (!svp && dash) {
 		/* the key doesn't exist with that name.  do s/-/_/g and
 		 * try again. */
-		register char * c;
-		for (c = SvPV_nolen (svname); c <= SvEND (svname) ; c++)
-			if (*c == '-')
-				*c = '_';
-		svp = hv_fetch (wrapper_hash,
-		                SvPV_nolen (svname), SvCUR (svname),
-		                create);
+		char * munged = g_strdelimit (g_strndup (name, len), "-", '_');
+		svp = hv_fetch (wrapper_hash, munged, len, create);
+		g_free (munged);
 	}
-	SvREFCNT_dec (svname);
 
 	return (svp ? *svp : NULL);
 }
 
 #if GPERL_THREAD_SAFE
 static void
-_inc_ref_and_count (GObject * key, gint value, gpointer user_data)
+_inc_ref_and_count (GObject * key, gint value, GHashTable * objects)
 {
-	PERL_UNUSED_VAR (user_data);
 	g_object_ref (key);
 	value += 1;
-	g_hash_table_replace (perl_gobjects, key, GINT_TO_POINTER (value));
+	g_hash_table_replace (objects, key, GINT_TO_POINTER (value));
 }
 #endif
 
@@ -1167,15 +1588,22 @@ that process.
 void
 CLONE (gchar * class)
     CODE:
-	/* !perl_gobjects can happen when no object has been created yet. */
-    	if (perl_gobject_tracking && perl_gobjects &&
+	/* the shards exist once tracking has been turned on.  only one
+	 * shard is locked at a time, so other threads can keep wrapping
+	 * objects in the rest while we walk them. */
+    	if (perl_gobject_tracking &&
 	    strcmp (class, "Glib::Object") == 0)
 	{
-		G_LOCK (perl_gobjects);
+		int i;
 /*g_printerr ("we're in clone: %s\n", class);*/
-		g_hash_table_foreach (perl_gobjects,
-				      (GHFunc)_inc_ref_and_count, NULL);
-		G_UNLOCK (perl_gobjects);
+		for (i = 0 ; i < PERL_GOBJECTS_N_SHARDS ; i++) {
+			PerlGObjectShard * shard = &perl_gobjects[i];
+			PERL_GOBJECTS_SHARD_LOCK (shard);
+			g_hash_table_foreach (shard->objects,
+					      (GHFunc)_inc_ref_and_count,
+					      shard->objects);
+			PERL_GOBJECTS_SHARD_UNLOCK (shard);
+		}
 	}
 
 #endif
@@ -1188,6 +1616,8 @@ gboolean
 set_threadsafe (class, gboolean threadsafe)
     CODE:
 #if GPERL_THREAD_SAFE
+	if (threadsafe)
+		perl_gobjects_init ();
 	RETVAL = perl_gobject_tracking = threadsafe;
 #else
 	PERL_UNUSED_VAR (threadsafe);
@@ -1272,21 +1702,22 @@ DESTROY (SV *sv)
 	if(perl_gobject_tracking)
 	{
 		gint count;
-		G_LOCK (perl_gobjects);
-		count = GPOINTER_TO_INT (g_hash_table_lookup (perl_gobjects, object));
+		PerlGObjectShard * shard = PERL_GOBJECTS_SHARD (object);
+		PERL_GOBJECTS_SHARD_LOCK (shard);
+		count = GPOINTER_TO_INT (g_hash_table_lookup (shard->objects, object));
 		count--;
 		if (count > 0)
 		{
 /*g_printerr ("decing: %p - %d\n", object, count);*/
-			g_hash_table_replace (perl_gobjects, object,
+			g_hash_table_replace (shard->objects, object,
 					      GINT_TO_POINTER (count));
 		}
 		else
 		{
 /*g_printerr ("removing: %p\n", object);*/
-			g_hash_table_remove (perl_gobjects, object);
+			g_hash_table_remove (shard->objects, object);
 		}
-		G_UNLOCK (perl_gobjects);
+		PERL_GOBJECTS_SHARD_UNLOCK (shard);
 	}
 #endif
         /* As of perl 5.16, even HVs that are not referenced by any SV will get
@@ -1327,15 +1758,11 @@ SV *
 g_object_new (class, ...)
 	const char *class
     PREINIT:
-	int n_params = 0;
-        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-	GParameter * params = NULL;
-        G_GNUC_END_IGNORE_DEPRECATIONS
+	PropertyBatch batch;
 	GType object_type;
 	GObject * object;
-	GObjectClass *oclass = NULL;
+	GObjectClass *oclass;
     CODE:
-        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 #define FIRST_ARG	1
 	object_type = gperl_object_type_from_package (class);
 	if (!object_type)
@@ -1347,44 +1774,49 @@ g_object_new (class, ...)
 	if (0 != ((items - 1) % 2))
 		croak ("new method expects name => value pairs "
 		       "(odd number of arguments detected)");
-	if (items > FIRST_ARG) {
-		int i;
+	ENTER;
+	property_batch_init (aTHX_ &batch, (items - FIRST_ARG) / 2);
+	if (batch.n) {
+		guint i;
 		if (NULL == (oclass = g_type_class_ref (object_type)))
 			croak ("could not get a reference to type class");
-		n_params = (items - FIRST_ARG) / 2;
-		params = g_new0 (GParameter, n_params);
-		for (i = 0 ; i < n_params ; i++) {
-			const char * key = SvPV_nolen (ST (FIRST_ARG+i*2+0));
+		SAVEDESTRUCTOR_X (type_class_release, oclass);
+		for (i = 0 ; i < batch.n ; i++) {
 			GParamSpec * pspec;
-			pspec = g_object_class_find_property (oclass, key);
-			if (!pspec) {
-				/* clean up... */
-				int j;
-				for (j = 0 ; j < i ; j++)
-					g_value_unset (&params[j].value);
-				g_free (params);
-				/* and bail out. */
-				croak ("type %s does not support property '%s'",
-				       class, key);
-			}
-			g_value_init (&params[i].value,
+			pspec = find_property_sv (oclass,
+						  ST (FIRST_ARG+i*2+0));
+			if (!pspec)
+				croak_unknown_property (object_type,
+							ST (FIRST_ARG+i*2+0));
+			g_value_init (&batch.values[i],
 			              G_PARAM_SPEC_VALUE_TYPE (pspec));
-			/* note: this croaks if there is a problem.  this is
-			 * usually the right thing to do, because if it
-			 * doesn't know how to convert the value, then there's
-			 * something seriously wrong; however, it means that
-			 * if there is a problem, all non-trivial values we've
-			 * converted will be leaked. */
-			gperl_value_from_sv (&params[i].value,
+			/* note: this croaks if there is a problem; the values
+			 * converted so far are unset by the batch. */
+			gperl_value_from_sv (&batch.values[i],
 			                     ST (FIRST_ARG+i*2+1));
-			params[i].name = key; /* will be valid until this
-			                       * xsub is finished */
+			batch.names[i] = g_param_spec_get_name (pspec);
 		}
 	}
 #undef FIRST_ARG
-
-	object = g_object_newv (object_type, n_params, params);
-        G_GNUC_END_IGNORE_DEPRECATIONS
+#if GLIB_CHECK_VERSION (2, 54, 0)
+	object = g_object_new_with_properties (object_type, batch.n,
+	                                       batch.names, batch.values);
+#else
+	{
+		GParameter * params = NULL;
+		guint i;
+		if (batch.n) {
+			/* the values stay owned by the batch */
+			params = g_new (GParameter, batch.n);
+			for (i = 0 ; i < batch.n ; i++) {
+				params[i].name = batch.names[i];
+				params[i].value = batch.values[i];
+			}
+		}
+		object = g_object_newv (object_type, batch.n, params);
+		g_free (params);
+	}
+#endif
 
 	/* this wrapper *must* own this object!
 	 * because we've been through initialization, the perl object
@@ -1392,14 +1824,7 @@ g_object_new (class, ...)
 	 * gperl_object_take_ownership to be called. */
 	RETVAL = gperl_new_object (object, TRUE);
 
-	if (n_params) {
-		int i;
-		for (i = 0 ; i < n_params ; i++)
-			g_value_unset (&params[i].value);
-		g_free (params);
-	}
-	if (oclass)
-		g_type_class_unref (oclass);
+	LEAVE;
     OUTPUT:
 	RETVAL
 
@@ -1425,6 +1850,7 @@ g_object_get (object, ...)
 	Glib::Object::get = 0
 	Glib::Object::get_property = 1
     PREINIT:
+	GObjectClass * oclass;
 	GValue value = {0,};
 	int i;
     CODE:
@@ -1432,10 +1858,16 @@ g_object_get (object, ...)
 	 * order to avoid that xsubs called by g_object_get_property or
 	 * _gperl_sv_from_value_internal overwrite what we put on the stack. */
 	PERL_UNUSED_VAR (ix);
+	oclass = G_OBJECT_GET_CLASS (object);
+	/* one property at a time, so that an unreadable one still yields
+	 * its type's default value, as it always has. */
 	for (i = 1; i < items; i++) {
-		char *name = SvPV_nolen (ST (i));
-		init_property_value (object, name, &value);
-		g_object_get_property (object, name, &value);
+		GParamSpec * pspec = find_property_sv (oclass, ST (i));
+		if (!pspec)
+			croak_unknown_property (G_OBJECT_TYPE (object), ST (i));
+		g_value_init (&value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+		g_object_get_property (object, g_param_spec_get_name (pspec),
+		                       &value);
 		ST (i - 1) =
 			sv_2mortal (
 				_gperl_sv_from_value_internal (&value, TRUE));
@@ -1467,24 +1899,131 @@ g_object_set (object, ...)
 	Glib::Object::set = 0
 	Glib::Object::set_property = 1
     PREINIT:
-	GValue value = {0,};
-	int i;
+	GObjectClass * oclass;
+	PropertyBatch batch;
+	guint i;
     CODE:
 	PERL_UNUSED_VAR (ix);
 	if (0 != ((items - 1) % 2))
 		croak ("set method expects name => value pairs "
 		       "(odd number of arguments detected)");
 
-	for (i = 1; i < items; i += 2) {
-		char *name = SvPV_nolen (ST (i));
-		SV *newval = ST (i + 1);
+	oclass = G_OBJECT_GET_CLASS (object);
+	ENTER;
+	property_batch_init (aTHX_ &batch, (items - 1) / 2);
+	for (i = 0; i < batch.n; i++) {
+		GParamSpec * pspec = find_property_sv (oclass, ST (1 + 2 * i));
+		if (!pspec)
+			croak_unknown_property (G_OBJECT_TYPE (object),
+						ST (1 + 2 * i));
+		batch.names[i] = g_param_spec_get_name (pspec);
+		g_value_init (&batch.values[i],
+		              G_PARAM_SPEC_VALUE_TYPE (pspec));
+		gperl_value_from_sv (&batch.values[i], ST (2 + 2 * i));
+#if !GLIB_CHECK_VERSION (2, 54, 0)
+		g_object_set_property (object, batch.names[i],
+		                       &batch.values[i]);
+#endif
+	}
+#if GLIB_CHECK_VERSION (2, 54, 0)
+	g_object_setv (object, batch.n, batch.names, batch.values);
+#endif
+	LEAVE;
+
+=for apidoc
+=for signature list = $class->install_property_accessors (...)
+=for arg ... (list) names of properties; all of I<$class>' own properties if empty
 
-		init_property_value (object, name, &value);
-		gperl_value_from_sv (&value, newval);
-		g_object_set_property (object, name, &value);
-		g_value_unset (&value);
+Create real methods C<get_foo> and C<set_foo> in the package I<$class>
+for the properties named in I<...>, with any '-' in the property name
+replaced by '_'.  Getters are only created for readable properties, setters
+only for writable ones that are not construct-only.  Existing methods of
+the same name are left alone.
+
+The accessors are bound to their GParamSpec when they are created, so
+calling C<< $object->get_foo >> is cheaper than C<< $object->get ('foo') >>
+and much cheaper than going through C<tie_properties>.  Setters still go
+through C<g_object_set_property>, so change notification works as usual.
+
+Returns the names of the methods that were created.
+
+=cut
+void
+g_object_install_property_accessors (class, ...)
+	const char * class
+    PREINIT:
+	GType type;
+	GObjectClass * oclass;
+	GParamSpec ** props = NULL;
+	guint n_props = 0, i;
+	AV * installed;
+    PPCODE:
+	type = gperl_object_type_from_package (class);
+	if (!type || !G_TYPE_IS_OBJECT (type))
+		croak ("package %s is not registered with GPerl as an object type",
+		       class);
+	oclass = g_type_class_ref (type);
+
+	if (items > 1) {
+		n_props = items - 1;
+		props = g_new0 (GParamSpec *, n_props);
+		for (i = 0 ; i < n_props ; i++) {
+			props[i] = find_property_sv (oclass, ST (i + 1));
+			if (!props[i]) {
+				g_free (props);
+				g_type_class_unref (oclass);
+				croak ("type %s does not support property '%s'",
+				       class, SvPV_nolen (ST (i + 1)));
+			}
+		}
+	} else {
+		GParamSpec ** all;
+		guint n_all;
+		all = g_object_class_list_properties (oclass, &n_all);
+		props = g_new0 (GParamSpec *, n_all);
+		for (i = 0 ; i < n_all ; i++)
+			if (all[i]->owner_type == type)
+				props[n_props++] = all[i];
+		g_free (all);
+	}
+
+	/* collect the results in an AV first, since perl might reallocate
+	 * the stack while we define subs. */
+	installed = (AV *) sv_2mortal ((SV *) newAV ());
+	for (i = 0 ; i < n_props ; i++) {
+		GParamSpec * pspec = props[i];
+		SV * method;
+
+		if (pspec->flags & G_PARAM_READABLE) {
+			method = newSV (0);
+			if (install_property_accessor (class, "get", pspec,
+						       gperl_object_property_getter,
+						       method))
+				av_push (installed, method);
+			else
+				SvREFCNT_dec (method);
+		}
+		if ((pspec->flags & G_PARAM_WRITABLE) &&
+		    !(pspec->flags & G_PARAM_CONSTRUCT_ONLY)) {
+			method = newSV (0);
+			if (install_property_accessor (class, "set", pspec,
+						       gperl_object_property_setter,
+						       method))
+				av_push (installed, method);
+			else
+				SvREFCNT_dec (method);
+		}
 	}
 
+	g_free (props);
+	g_type_class_unref (oclass);
+
+	n_props = av_len (installed) + 1;
+	EXTEND (SP, (int) n_props);
+	for (i = 0 ; i < n_props ; i++)
+		PUSHs (sv_2mortal (SvREFCNT_inc (*av_fetch (installed, i, 0))));
+
+
 =for apidoc
 
 Emits a "notify" signal for the property I<$property> on I<$object>.
@@ -30,10 +30,11 @@
 #include "gperl.h"
 #include "gperl-gtypes.h"
 #include "gperl-private.h" /* for SAVED_STACK_SV */
+#include "gperl_marshal.h"
 
 /*
  * here's a nice G_LOCK-like front-end to GStaticRecMutex.  we need this 
- * to keep other threads from fiddling with the closures list while we're
+ * to keep other threads from fiddling with the closure index while we're
  * modifying it.
  */
 #ifdef G_THREADS_ENABLED
@@ -133,36 +134,106 @@ newSVGSignalQuery (GSignalQuery * query)
 now back to our regularly-scheduled bindings.
 */
 
-static GSList * closures = NULL;
+/*
+ * every GPerlClosure connected by gperl_signal_connect is indexed by the
+ * instance it is connected to, and within that by the identity of its
+ * callback, so that the *_by_func functions only look at the handlers of
+ * one instance with the right callback:
+ *
+ *   closures_by_instance: instance -> (callback key -> GSList of records)
+ *
+ * the callback key is the referent for references (i.e., the CV), and
+ * the interned string for anything else (i.e., function names).
+ */
+typedef struct {
+	GPerlClosure * closure;
+	gpointer       instance;
+	gconstpointer  callback_key;
+} ClosureRecord;
+
+static GHashTable * closures_by_instance = NULL;
 GPERL_REC_LOCK_DEFINE_STATIC (closures);
 
+static gconstpointer
+closure_callback_key (SV * callback)
+{
+	if (!callback)
+		return NULL;
+	if (SvROK (callback))
+		return SvRV (callback);
+	return g_quark_to_string (g_quark_from_string (SvPV_nolen (callback)));
+}
+
 static void
-forget_closure (SV * callback,
+forget_closure (ClosureRecord * record,
                 GPerlClosure * closure)
 {
+	GHashTable * by_callback;
+
 #ifdef NOISY
-	warn ("forget_closure %p / %p", callback, closure);
+	warn ("forget_closure %p / %p", record->closure->callback, closure);
 #else
-	PERL_UNUSED_VAR (callback);
+	PERL_UNUSED_VAR (closure);
 #endif
-	
+
 	GPERL_REC_LOCK (closures);
-	closures = g_slist_remove (closures, closure);
+	by_callback = g_hash_table_lookup (closures_by_instance,
+	                                   record->instance);
+	if (by_callback) {
+		GSList * list = g_hash_table_lookup (by_callback,
+		                                     record->callback_key);
+		list = g_slist_remove (list, record);
+		if (list)
+			g_hash_table_insert (by_callback,
+			                     (gpointer) record->callback_key,
+			                     list);
+		else
+			g_hash_table_remove (by_callback,
+			                     record->callback_key);
+		if (g_hash_table_size (by_callback) == 0)
+			g_hash_table_remove (closures_by_instance,
+			                     record->instance);
+	}
 	GPERL_REC_UNLOCK (closures);
+
+	g_free (record);
 }
 
 static void
-remember_closure (GPerlClosure * closure)
+remember_closure (gpointer instance,
+                  GPerlClosure * closure)
 {
+	ClosureRecord * record;
+	GHashTable * by_callback;
+	GSList * list;
+
 #ifdef NOISY
 	warn ("remember_closure %p / %p", closure->callback, closure);
 	warn ("   callback %s\n", SvPV_nolen (closure->callback));
 #endif
+	record = g_new (ClosureRecord, 1);
+	record->closure = closure;
+	record->instance = instance;
+	record->callback_key = closure_callback_key (closure->callback);
+
 	GPERL_REC_LOCK (closures);
-	closures = g_slist_prepend (closures, closure);
+	if (!closures_by_instance)
+		closures_by_instance = g_hash_table_new_full
+			(g_direct_hash, g_direct_equal,
+			 NULL, (GDestroyNotify) g_hash_table_destroy);
+	by_callback = g_hash_table_lookup (closures_by_instance, instance);
+	if (!by_callback) {
+		by_callback = g_hash_table_new (g_direct_hash, g_direct_equal);
+		g_hash_table_insert (closures_by_instance, instance,
+		                     by_callback);
+	}
+	list = g_hash_table_lookup (by_callback, record->callback_key);
+	g_hash_table_insert (by_callback, (gpointer) record->callback_key,
+	                     g_slist_prepend (list, record));
 	GPERL_REC_UNLOCK (closures);
+
 	g_closure_add_invalidate_notifier ((GClosure *) closure,
-	                                   closure->callback,
+	                                   record,
 	                                   (GClosureNotify) forget_closure);
 }
 
@@ -198,6 +269,36 @@ bugfixes.
 static GHashTable * marshallers_by_type = NULL;
 G_LOCK_DEFINE_STATIC (marshallers_by_type);
 
+/* lookup_marshaller's results, per (instance type, signal id, detail), so
+ * that connecting to many instances of a class walks the ancestry only
+ * once.  Protected by the marshallers_by_type lock and thrown away whenever
+ * a marshaller is (un)registered. */
+typedef struct {
+	GType           instance_type;
+	guint           signal_id;
+	GQuark          detail;
+	GClosureMarshal marshaller; /* NULL if there is none */
+} ResolvedMarshaller;
+
+static GHashTable * resolved_marshallers = NULL;
+
+static guint
+resolved_marshaller_hash (gconstpointer key)
+{
+	const ResolvedMarshaller * r = key;
+	return ((guint) r->instance_type * 31 + r->signal_id) * 31 + r->detail;
+}
+
+static gboolean
+resolved_marshaller_equal (gconstpointer a,
+                           gconstpointer b)
+{
+	const ResolvedMarshaller * ra = a, * rb = b;
+	return ra->instance_type == rb->instance_type
+	    && ra->signal_id == rb->signal_id
+	    && ra->detail == rb->detail;
+}
+
 /* gobject treats hyphens and underscores in signal names as equivalent.  We
  * thus need to do this as well to ensure that a custom marshaller is used for
  * all spellings of a signal name. */
@@ -252,6 +353,10 @@ gperl_signal_set_marshaller_for (GType instance_type,
 			                     canonical_detailed_signal);
 			g_free (canonical_detailed_signal);
 		}
+		if (resolved_marshallers) {
+			g_hash_table_destroy (resolved_marshallers);
+			resolved_marshallers = NULL;
+		}
 	}
 	G_UNLOCK (marshallers_by_type);
 }
@@ -282,8 +387,33 @@ lookup_marshaller (GType instance_type,
                    char * detailed_signal)
 {
 	GClosureMarshal marshaller = NULL;
+	ResolvedMarshaller key, * resolved = NULL;
+	gboolean cacheable;
+
 	G_LOCK (marshallers_by_type);
-	if (marshallers_by_type) {
+	if (!marshallers_by_type) {
+		G_UNLOCK (marshallers_by_type);
+		return NULL;
+	}
+
+	/* names that don't parse are left to g_signal_connect_closure to
+	 * complain about.  the detail quark is forced into existence (as
+	 * connecting will do anyway), since otherwise an unknown detail
+	 * would come back as 0 and share the key of the plain signal. */
+	cacheable = g_signal_parse_name (detailed_signal, instance_type,
+	                                 &key.signal_id, &key.detail, TRUE);
+	if (cacheable) {
+		key.instance_type = instance_type;
+		if (resolved_marshallers)
+			resolved = g_hash_table_lookup (resolved_marshallers,
+			                                &key);
+		if (resolved) {
+			G_UNLOCK (marshallers_by_type);
+			return resolved->marshaller;
+		}
+	}
+
+	{
 		GType type = instance_type;
 		/* We need to walk the ancestry to make sure that, say,
 		 * GtkFileChooseDialog also gets the custom "response"
@@ -305,8 +435,21 @@ lookup_marshaller (GType instance_type,
 			                       *interface, detailed_signal);
 				interface++;
 			}
+			g_free (interface_types);
 		}
 	}
+
+	if (cacheable) {
+		if (!resolved_marshallers)
+			resolved_marshallers = g_hash_table_new_full
+				(resolved_marshaller_hash,
+				 resolved_marshaller_equal,
+				 g_free, NULL);
+		resolved = g_new (ResolvedMarshaller, 1);
+		*resolved = key;
+		resolved->marshaller = marshaller;
+		g_hash_table_insert (resolved_marshallers, resolved, resolved);
+	}
 	G_UNLOCK (marshallers_by_type);
 	return marshaller;
 }
@@ -350,7 +493,11 @@ gperl_signal_connect (SV * instance,
 
 	if (id > 0) {
 		closure->id = id;
-		remember_closure (closure);
+		/* lets gperl_closure_marshal trust invocation hints for this
+		 * signal; see marshal_signature_lookup. */
+		g_signal_parse_name (detailed_signal, G_OBJECT_TYPE (object),
+		                     &closure->signal_id, NULL, FALSE);
+		remember_closure (object, closure);
 	} else {
 		/* not connected, usually bad detailed_signal name */
 		g_closure_unref ((GClosure*) closure);
@@ -378,6 +525,17 @@ typedef guint (*sig_match_callback) (gpointer           instance,
                                      gpointer           func,
                                      gpointer           data);
 
+/* GHFunc collecting the closures in one callback bucket */
+static void
+collect_closures (gpointer key,
+                  GSList * list,
+                  GPtrArray * found)
+{
+	PERL_UNUSED_VAR (key);
+	for ( ; list != NULL ; list = list->next)
+		g_ptr_array_add (found, ((ClosureRecord *) list->data)->closure);
+}
+
 static guint
 foreach_closure_matched (gpointer instance,
                          GSignalMatchType mask,
@@ -388,7 +546,6 @@ foreach_closure_matched (gpointer instance,
                          sig_match_callback callback)
 {
 	guint n = 0;
-	GSList * i;
 
 	if (mask & G_SIGNAL_MATCH_CLOSURE || /* this isn't too likely */
 	    mask & G_SIGNAL_MATCH_FUNC ||
@@ -404,31 +561,50 @@ foreach_closure_matched (gpointer instance,
 		 * on to the real C functions to do any other filtering for
 		 * us.
 		 */
-		/* we'll compare SVs by their stringified values.  cache the
-		 * stringified needles, but there's no way to cache the
-		 * haystack. */
-		const char * str_func = func ? SvPV_nolen (func) : NULL;
+		/* functions are compared by identity, through the index.
+		 * data is compared by stringified value, but only for the
+		 * handlers with the right function on this instance. */
 		const char * str_data = data ? SvPV_nolen (data) : NULL;
+		GPtrArray * found = g_ptr_array_new ();
+		GHashTable * by_callback;
+		guint i;
 
 		mask &= ~(G_SIGNAL_MATCH_FUNC | G_SIGNAL_MATCH_DATA);
 		mask |= G_SIGNAL_MATCH_CLOSURE;
 
-		/* this is a little hairy because the callback may disconnect
-		 * a closure, which would modify the list while we're iterating
-		 * over it. */
+		/* the callback may disconnect closures, which would modify
+		 * the index, so collect the candidates first. */
 		GPERL_REC_LOCK (closures);
-		i = closures;
-		while (i != NULL) {
-			GPerlClosure * c = (GPerlClosure*) i->data;
-			i = i->next;
-			if ((!func || strEQ (str_func, SvPV_nolen (c->callback))) &&
-			    (!data || strEQ (str_data, SvPV_nolen (c->data)))) {
+		by_callback = closures_by_instance
+		            ? g_hash_table_lookup (closures_by_instance,
+		                                   instance)
+		            : NULL;
+		if (by_callback) {
+			if (func)
+				collect_closures (NULL,
+				                  g_hash_table_lookup
+				                    (by_callback,
+				                     closure_callback_key (func)),
+				                  found);
+			else
+				g_hash_table_foreach (by_callback,
+				                      (GHFunc) collect_closures,
+				                      found);
+		}
+		for (i = 0 ; i < found->len ; i++)
+			g_closure_ref (g_ptr_array_index (found, i));
+		GPERL_REC_UNLOCK (closures);
+
+		for (i = 0 ; i < found->len ; i++) {
+			GPerlClosure * c = g_ptr_array_index (found, i);
+			if (!data ||
+			    strEQ (str_data, c->data ? SvPV_nolen (c->data) : ""))
 				n += callback (instance, mask, signal_id,
 				               detail, (GClosure*)c,
 				               NULL, NULL);
-			}
+			g_closure_unref ((GClosure *) c);
 		}
-		GPERL_REC_UNLOCK (closures);
+		g_ptr_array_free (found, TRUE);
 	} else {
 		/* we're not matching against a closure, so we can just
 		 * pass this on through. */
@@ -508,6 +684,300 @@ gperl_signal_emission_hook (GSignalInvocationHint * ihint,
 }
 
 
+/*
+ * Lazy emission hooks.  Instead of an array of converted parameters and a
+ * hash for the invocation hint, these get a Glib::Signal::Emission object
+ * that converts parameters only when asked for them, and is only valid
+ * during the hook call.  Emissions on instances of the wrong type are
+ * filtered out before calling into perl at all.  The emission object is
+ * reused from one call to the next unless the hook kept a reference to it;
+ * a recursive call, made while the shared object is in use, gets one of
+ * its own.
+ */
+typedef struct {
+	GSignalInvocationHint * ihint;
+	guint                   n_param_values;
+	const GValue          * param_values;
+} EmissionView;
+
+typedef struct {
+	GPerlCallback * callback;
+	GType           instance_type; /* 0 for any */
+	SV            * view;          /* RV to a Glib::Signal::Emission */
+} LazyEmissionHook;
+
+static EmissionView *
+SvEmissionView (SV * sv)
+{
+	EmissionView * view;
+	if (!gperl_sv_is_ref (sv) ||
+	    !sv_derived_from (sv, "Glib::Signal::Emission"))
+		croak ("%s is not of type Glib::Signal::Emission",
+		       gperl_format_variable_for_output (sv));
+	view = INT2PTR (EmissionView *, SvIV (SvRV (sv)));
+	if (!view)
+		croak ("the signal emission is over; Glib::Signal::Emission "
+		       "objects can only be used inside the hook");
+	return view;
+}
+
+static gboolean
+gperl_signal_lazy_emission_hook (GSignalInvocationHint * ihint,
+				 guint n_param_values,
+				 const GValue * param_values,
+				 gpointer data)
+{
+	LazyEmissionHook * hook = (LazyEmissionHook *) data;
+	EmissionView view;
+	SV * emission;
+	gboolean shared;
+	gboolean retval = TRUE;
+	int count;
+	dGPERL_CALLBACK_MARSHAL_SP;
+
+	if (hook->instance_type &&
+	    !g_type_is_a (G_TYPE_FROM_INSTANCE (g_value_peek_pointer
+	                                          (&param_values[0])),
+	                  hook->instance_type))
+		return TRUE;
+
+	GPERL_CALLBACK_MARSHAL_INIT (hook->callback);
+
+	view.ihint = ihint;
+	view.n_param_values = n_param_values;
+	view.param_values = param_values;
+
+	if (!hook->view)
+		hook->view = sv_setref_iv (newSV (0), "Glib::Signal::Emission",
+					   0);
+	shared = SvIV (SvRV (hook->view)) == 0;
+	emission = shared
+	         ? hook->view
+	         : sv_setref_iv (newSV (0), "Glib::Signal::Emission", 0);
+	sv_setiv (SvRV (emission), PTR2IV (&view));
+
+	ENTER;
+	SAVETMPS;
+
+	PUSHMARK (SP);
+	XPUSHs (emission);
+	if (hook->callback->data)
+		XPUSHs (hook->callback->data);
+	PUTBACK;
+
+	count = call_sv (hook->callback->func, G_SCALAR | G_EVAL);
+	SPAGAIN;
+	if (count > 0) {
+		SV * ret = POPs;
+		if (!SvTRUE (ERRSV))
+			retval = SvTRUE (ret);
+	}
+	PUTBACK;
+
+	if (SvTRUE (ERRSV))
+		gperl_run_exception_handlers ();
+
+	FREETMPS;
+	LEAVE;
+
+	/* the view points into this stack frame, so invalidate it; if the
+	 * hook held on to the shared object, start over with a fresh one. */
+	sv_setiv (SvRV (emission), 0);
+	if (!shared)
+		SvREFCNT_dec (emission);
+	else if (SvREFCNT (emission) > 1 || SvREFCNT (SvRV (emission)) > 1) {
+		SvREFCNT_dec (hook->view);
+		hook->view = NULL;
+	}
+
+	return retval;
+}
+
+static void
+lazy_emission_hook_destroy (LazyEmissionHook * hook)
+{
+	if (hook->view) {
+		sv_setiv (SvRV (hook->view), 0);
+		SvREFCNT_dec (hook->view);
+	}
+	gperl_callback_destroy (hook->callback);
+	g_free (hook);
+}
+
+/*
+ * Signal handles: everything signal_emit works out on each call -- the
+ * parsed name, the signature and the converters for it -- resolved once.
+ * The GValues for an emission are kept in the handle and reset, not freed,
+ * after use; only a recursive emission through the same handle needs a
+ * (stack allocated) buffer of its own.
+ */
+typedef struct {
+	GType                        instance_type;
+	guint                        signal_id;
+	GQuark                       detail;
+	guint                        n_params;
+	GType                        return_type;
+	GType                      * param_types;
+	const GPerlValueConverter ** param_converters;
+	const GPerlValueConverter  * return_converter; /* NULL for void */
+	GValue                     * values; /* instance + n_params */
+	gboolean                     values_in_use;
+} SignalHandle;
+
+static void
+signal_handle_init_values (SignalHandle * handle,
+			   GValue * values)
+{
+	guint i;
+	memset (values, 0, sizeof (GValue) * (handle->n_params + 1));
+	g_value_init (&values[0], handle->instance_type);
+	for (i = 0 ; i < handle->n_params ; i++)
+		g_value_init (&values[i+1], handle->param_types[i]);
+}
+
+static SignalHandle *
+signal_handle_new (GType instance_type,
+		   guint signal_id,
+		   GQuark detail)
+{
+	SignalHandle * handle;
+	GSignalQuery query;
+	guint i;
+
+	g_signal_query (signal_id, &query);
+
+	handle = g_new0 (SignalHandle, 1);
+	handle->instance_type = instance_type;
+	handle->signal_id = signal_id;
+	handle->detail = detail;
+	handle->n_params = query.n_params;
+	handle->return_type = query.return_type & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+	handle->param_types = g_new (GType, query.n_params);
+	handle->param_converters =
+		g_new (const GPerlValueConverter *, query.n_params);
+	for (i = 0 ; i < query.n_params ; i++) {
+		/* the converter's gtype may be G_TYPE_INVALID for the generic
+		 * fallback, so the values are initialized from these. */
+		handle->param_types[i] =
+			query.param_types[i] & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+		handle->param_converters[i] =
+			_gperl_value_converter_lookup (handle->param_types[i]);
+	}
+	if (handle->return_type != G_TYPE_NONE)
+		handle->return_converter =
+			_gperl_value_converter_lookup (handle->return_type);
+
+	handle->values = g_new (GValue, query.n_params + 1);
+	signal_handle_init_values (handle, handle->values);
+
+	return handle;
+}
+
+static void
+signal_handle_free (SignalHandle * handle)
+{
+	guint i;
+	for (i = 0 ; i < handle->n_params + 1 ; i++)
+		g_value_unset (&handle->values[i]);
+	g_free (handle->values);
+	g_free (handle->param_types);
+	g_free (handle->param_converters);
+	g_free (handle);
+}
+
+static SignalHandle *
+SvSignalHandle (SV * sv)
+{
+	if (!gperl_sv_is_ref (sv) || !sv_derived_from (sv, "Glib::Signal"))
+		croak ("%s is not of type Glib::Signal",
+		       gperl_format_variable_for_output (sv));
+	return INT2PTR (SignalHandle *, SvIV (SvRV (sv)));
+}
+
+/* savestack destructor, so that a croak while converting arguments or
+ * in a handler doesn't leave values behind. */
+static void
+signal_handle_release_values (pTHX_ void * data)
+{
+	SignalHandle * handle = data;
+	guint i;
+	for (i = 0 ; i < handle->n_params + 1 ; i++)
+		g_value_reset (&handle->values[i]);
+	handle->values_in_use = FALSE;
+}
+
+static void
+signal_handle_unset_values (pTHX_ void * data)
+{
+	GValue * values = data;
+	guint i;
+	/* terminated by the unused value after the parameters */
+	for (i = 0 ; G_IS_VALUE (&values[i]) ; i++)
+		g_value_unset (&values[i]);
+}
+
+/* get a parameter buffer for one (batch of) emission(s), which is released
+ * at the next LEAVE.  values[0] is left for the instance. */
+static GValue *
+signal_handle_get_values (pTHX_ SignalHandle * handle,
+			  GValue * stack_values)
+{
+	if (!handle->values_in_use) {
+		handle->values_in_use = TRUE;
+		SAVEDESTRUCTOR_X (signal_handle_release_values, handle);
+		return handle->values;
+	}
+	signal_handle_init_values (handle, stack_values);
+	memset (&stack_values[handle->n_params + 1], 0, sizeof (GValue));
+	SAVEDESTRUCTOR_X (signal_handle_unset_values, stack_values);
+	return stack_values;
+}
+
+/* converting may run perl code (magic, overloading) and move the stack
+ * around, so the arguments are passed by stack index. */
+static void
+signal_handle_set_args (pTHX_ SignalHandle * handle,
+			GValue * values,
+			I32 first_arg)
+{
+	guint i;
+	for (i = 0 ; i < handle->n_params ; i++) {
+		SV * sv = PL_stack_base[first_arg + i];
+		_gperl_converter_value_from_sv (handle->param_converters[i],
+						&values[i+1], sv);
+	}
+}
+
+/* emit on one instance; returns the new return value SV, or NULL. */
+static SV *
+signal_handle_emit (SignalHandle * handle,
+		    GValue * values,
+		    SV * instance)
+{
+	GObject * object = gperl_get_object_check (instance,
+						   handle->instance_type);
+	SV * retsv = NULL;
+
+	g_value_set_object (&values[0], object);
+
+	if (handle->return_converter) {
+		GValue ret = {0,};
+		g_value_init (&ret, handle->return_type);
+		g_signal_emitv (values, handle->signal_id, handle->detail,
+				&ret);
+		retsv = _gperl_converter_sv_from_value
+				(handle->return_converter, &ret, TRUE);
+		g_value_unset (&ret);
+	} else {
+		g_signal_emitv (values, handle->signal_id, handle->detail,
+				NULL);
+	}
+
+	g_value_set_object (&values[0], NULL);
+
+	return retsv;
+}
+
 =back
 
 =cut
@@ -554,6 +1024,280 @@ BOOT:
 
 =cut
 
+=for apidoc
+=for signature accumulator = Glib::Signal::ACCUMULATE_FIRST_WINS
+=for signature accumulator = Glib::Signal::ACCUMULATE_TRUE_HANDLED
+=for signature accumulator = Glib::Signal::ACCUMULATE_LOGICAL_OR
+=for signature accumulator = Glib::Signal::ACCUMULATE_SUM
+=for signature accumulator = Glib::Signal::ACCUMULATE_COLLECT
+
+Constants selecting one of the built-in signal accumulators, for the
+I<accumulator> key of a signal description passed to
+C<< Glib::Type->register_object >> or L<Glib::Object::Subclass>.  They run
+entirely in C.  See L<Glib::Object::Subclass/SIGNALS> for what each one
+does.
+
+=cut
+SV *
+ACCUMULATE_FIRST_WINS ()
+    ALIAS:
+	ACCUMULATE_TRUE_HANDLED = 1
+	ACCUMULATE_LOGICAL_OR = 2
+	ACCUMULATE_SUM = 3
+	ACCUMULATE_COLLECT = 4
+    PREINIT:
+	static const char * names[] = {
+		"first-wins", "true-handled", "logical-or", "sum", "collect"
+	};
+    CODE:
+	/* a blessed string, so that it can never be mistaken for the name
+	 * of a perl sub. */
+	RETVAL = sv_bless (newRV_noinc (newSVpv (names[ix], 0)),
+	                   gv_stashpv ("Glib::Signal::Accumulator", TRUE));
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+=for signature signal = Glib::Signal->lookup ($object_or_class_name, $detailed_name)
+=for arg object_or_class_name (GObject or class name)
+=for arg detailed_name (string) the signal's name, optionally with a detail
+
+Look up a signal once, for repeated emission with C<emit> or C<emit_many>.
+The handle remembers the signal's id, detail and signature, so emitting
+through it skips all the setup C<< Glib::Object::signal_emit >> does on
+every call.  The handle can be used with any instance of
+I<$object_or_class_name>.
+
+=cut
+SV *
+lookup (class, object_or_class_name, detailed_name)
+	SV * object_or_class_name
+	const char * detailed_name
+    PREINIT:
+	GType instance_type;
+	guint signal_id;
+	GQuark detail;
+    CODE:
+	instance_type = get_gtype_or_croak (object_or_class_name);
+	if (!g_type_is_a (instance_type, G_TYPE_OBJECT))
+		croak ("%s is not an object type",
+		       g_type_name (instance_type));
+	signal_id = parse_signal_name_or_croak (detailed_name, instance_type,
+						&detail);
+	RETVAL = sv_setref_pv (newSV (0), "Glib::Signal",
+			       signal_handle_new (instance_type, signal_id,
+						  detail));
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+=for signature retval = $signal->emit ($instance, ...)
+
+Emit the signal on I<$instance>, which must be of the type the signal was
+looked up for, with the arguments in I<...>.  Like
+C<< Glib::Object::signal_emit >>, returns the signal's return value, if
+it has one.
+
+=cut
+void
+emit (signal, instance, ...)
+	SV * signal
+	SV * instance
+    PREINIT:
+	SignalHandle * handle;
+	GValue * values;
+	SV * retsv;
+    PPCODE:
+#define ARGOFFSET 2
+	handle = SvSignalHandle (signal);
+	if (((guint)(items-ARGOFFSET)) != handle->n_params)
+		croak ("Incorrect number of arguments for emission of signal %s; need %d but got %d",
+		       g_signal_name (handle->signal_id),
+		       handle->n_params, (gint) items-ARGOFFSET);
+	ENTER;
+	/* a handler may drop the last reference to the handle; keep it
+	 * alive until the values are released. */
+	SAVEFREESV (SvREFCNT_inc (SvRV (signal)));
+	values = signal_handle_get_values
+		(aTHX_ handle, g_newa (GValue, handle->n_params + 2));
+	signal_handle_set_args (aTHX_ handle, values, ax + ARGOFFSET);
+	retsv = SAVED_STACK_SV (signal_handle_emit (handle, values, instance));
+	LEAVE;
+	if (retsv) {
+		EXTEND (SP, 1);
+		PUSHs (sv_2mortal (retsv));
+	}
+#undef ARGOFFSET
+
+=for apidoc
+=for signature retvals = $signal->emit_many ($instances, ...)
+=for arg instances (array reference) the instances to emit the signal on
+=for arg ... (list) arguments for the signal's handlers
+
+Emit the signal on each of I<@$instances> in turn, with the same arguments
+I<...>, which are converted only once.  If the signal has a return value,
+returns the list of return values, one per instance.
+
+=cut
+void
+emit_many (signal, instances, ...)
+	SV * signal
+	SV * instances
+    PREINIT:
+	SignalHandle * handle;
+	GValue * values;
+	AV * av;
+	SSize_t i, n;
+    PPCODE:
+#define ARGOFFSET 2
+	handle = SvSignalHandle (signal);
+	if (!gperl_sv_is_array_ref (instances))
+		croak ("instances must be an array reference");
+	if (((guint)(items-ARGOFFSET)) != handle->n_params)
+		croak ("Incorrect number of arguments for emission of signal %s; need %d but got %d",
+		       g_signal_name (handle->signal_id),
+		       handle->n_params, (gint) items-ARGOFFSET);
+	av = (AV *) SvRV (instances);
+	n = av_len (av) + 1;
+	ENTER;
+	/* a handler may drop the last reference to the handle; keep it
+	 * alive until the values are released. */
+	SAVEFREESV (SvREFCNT_inc (SvRV (signal)));
+	values = signal_handle_get_values
+		(aTHX_ handle, g_newa (GValue, handle->n_params + 2));
+	signal_handle_set_args (aTHX_ handle, values, ax + ARGOFFSET);
+	for (i = 0 ; i < n ; i++) {
+		SV ** svp = av_fetch (av, i, FALSE);
+		SV * retsv = SAVED_STACK_SV (signal_handle_emit
+				(handle, values, svp ? *svp : &PL_sv_undef));
+		if (retsv)
+			XPUSHs (sv_2mortal (retsv));
+	}
+	LEAVE;
+#undef ARGOFFSET
+
+=for apidoc __hide__
+Handles are not duplicated into new interpreter threads; DESTROY would
+otherwise free the same C structure once per thread.
+=cut
+IV
+CLONE_SKIP (...)
+    CODE:
+	RETVAL = 1;
+    OUTPUT:
+	RETVAL
+
+void
+DESTROY (signal)
+	SV * signal
+    CODE:
+	signal_handle_free (SvSignalHandle (signal));
+
+
+MODULE = Glib::Signal	PACKAGE = Glib::Signal::Emission
+
+=for object Glib::Signal::Emission A signal emission seen by a lazy emission hook
+
+=for position DESCRIPTION
+
+=head1 DESCRIPTION
+
+Objects of this class are handed to hooks installed with
+C<< Glib::Object::signal_add_emission_hook_lazy >>.  They give access to the
+emission's parameters, converting each only when it is asked for, and are
+only valid while the hook runs.
+
+=cut
+
+=for see_also Glib::Object
+
+=cut
+
+=for apidoc
+Returns the number of parameters, including the instance.
+=cut
+guint
+n_params (emission)
+	SV * emission
+    CODE:
+	RETVAL = SvEmissionView (emission)->n_param_values;
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+Returns the I<$index>th parameter of the emission; 0 is the instance the
+signal is emitted on.
+=cut
+SV *
+param (emission, index)
+	SV * emission
+	guint index
+    PREINIT:
+	EmissionView * view;
+    CODE:
+	view = SvEmissionView (emission);
+	if (index >= view->n_param_values)
+		croak ("parameter index %u out of range; the signal has %u",
+		       index, view->n_param_values);
+	RETVAL = gperl_sv_from_value (&view->param_values[index]);
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+Returns the instance the signal is emitted on.
+=cut
+SV *
+instance (emission)
+	SV * emission
+    CODE:
+	RETVAL = gperl_sv_from_value (&SvEmissionView (emission)->param_values[0]);
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+Returns all parameters, instance first, like the C<$parameters> of an
+ordinary emission hook.
+=cut
+void
+params (emission)
+	SV * emission
+    PREINIT:
+	EmissionView * view;
+	guint i;
+    PPCODE:
+	view = SvEmissionView (emission);
+	EXTEND (SP, (int) view->n_param_values);
+	for (i = 0 ; i < view->n_param_values ; i++)
+		SAVED_STACK_PUSHs (sv_2mortal (gperl_sv_from_value
+					(&view->param_values[i])));
+
+const gchar *
+signal_name (emission)
+	SV * emission
+    CODE:
+	RETVAL = g_signal_name (SvEmissionView (emission)->ihint->signal_id);
+    OUTPUT:
+	RETVAL
+
+=for apidoc
+Returns the emission's detail, or undef.
+=cut
+const gchar_ornull *
+detail (emission)
+	SV * emission
+    CODE:
+	RETVAL = g_quark_to_string (SvEmissionView (emission)->ihint->detail);
+    OUTPUT:
+	RETVAL
+
+GSignalFlags
+run_type (emission)
+	SV * emission
+    CODE:
+	RETVAL = SvEmissionView (emission)->ihint->run_type;
+    OUTPUT:
+	RETVAL
+
 
 MODULE = Glib::Signal	PACKAGE = Glib::Object	PREFIX = g_
 
@@ -819,6 +1563,64 @@ g_signal_add_emission_hook (object_or_class_name, detailed_signal, hook_func, ho
     OUTPUT:
 	RETVAL
 
+=for apidoc
+=for arg detailed_signal (string) of the form "signal-name::detail"
+=for arg hook_func (subroutine)
+Like C<add_emission_hook>, but for hooks that are interested in few of the
+emissions they see, or in few of their parameters, such as tracing hooks.
+
+The hook is only called for emissions on instances of
+I<$object_or_class_name>'s type (or any type derived from it), and only for
+the detail in I<$detailed_signal>, if any; other emissions never make it into
+perl.  It is called like this:
+
+  sub emission_hook {
+      my ($emission, $hook_data) = @_;
+      # the parameters are converted only when asked for
+      my $instance = $emission->instance;
+      my $first_arg = $emission->param (1);
+      return $stay_connected;  # boolean
+  }
+
+The I<$emission> object (a Glib::Signal::Emission) is only valid while the
+hook runs.  Use C<remove_emission_hook> to remove the hook again.
+
+=cut
+gulong
+g_signal_add_emission_hook_lazy (object_or_class_name, detailed_signal, hook_func, hook_data=NULL)
+	SV * object_or_class_name
+	const char * detailed_signal
+	SV * hook_func
+	SV * hook_data
+    PREINIT:
+	GType              itype;
+	GObjectClass *     object_class;
+	guint              signal_id;
+	GQuark             quark;
+	GSignalQuery       query;
+	LazyEmissionHook * hook;
+    CODE:
+	itype = get_gtype_or_croak (object_or_class_name);
+
+	/* See the xsub for g_object_find_property in GObject.xs for why the
+	 * class ref/unref stunt is necessary. */
+	object_class = g_type_class_ref (itype);
+
+	signal_id = parse_signal_name_or_croak (detailed_signal, itype, &quark);
+	g_signal_query (signal_id, &query);
+
+	hook = g_new0 (LazyEmissionHook, 1);
+	hook->callback = gperl_callback_new (hook_func, hook_data, 0, NULL, 0);
+	/* no need to check types if every instance qualifies */
+	hook->instance_type = itype == query.itype ? 0 : itype;
+	RETVAL = g_signal_add_emission_hook
+			(signal_id, quark, gperl_signal_lazy_emission_hook,
+			 hook, (GDestroyNotify) lazy_emission_hook_destroy);
+
+	g_type_class_unref (object_class);
+    OUTPUT:
+	RETVAL
+
 ##void	g_signal_remove_emission_hook	    (guint		  signal_id,
 ##					     gulong		  hook_id);
 =for apidoc
@@ -311,6 +311,118 @@ gperl_type_flags_get_values (GType flags_type)
 }
 
 
+/*
+ * Looking values up by scanning the GEnumValue/GFlagsValue arrays gets
+ * expensive for big types marshalled in tight loops, so the first lookup
+ * on a type builds an index, which is then kept in the type's qdata.  The
+ * value arrays belong to classes we never unref (see gperl_type_class), so
+ * the index can point straight into them.  For the way back, we remember
+ * each nick's length and hash so that the returned scalars can share the
+ * string in perl's string table instead of copying it.
+ */
+
+typedef struct {
+	gint         value;
+	const char * nick;
+	STRLEN       nick_len;
+	U32          nick_hash;
+} EnumEntry;
+
+typedef struct {
+	EnumEntry  * entries;
+	guint        n_entries;
+	GHashTable * by_name;  /* nicks and names, '-' == '_' */
+	GHashTable * by_value; /* only first entry per value */
+} EnumIndex;
+
+G_LOCK_DEFINE_STATIC (enum_index);
+
+static void
+enum_index_add (EnumIndex * index,
+		gint value,
+		const char * name,
+		const char * nick)
+{
+	EnumEntry * entry = &index->entries[index->n_entries++];
+
+	entry->value = value;
+	entry->nick = nick;
+	entry->nick_len = strlen (nick);
+	PERL_HASH (entry->nick_hash, nick, entry->nick_len);
+
+	/* the linear scans this replaces returned the first match, so never
+	 * overwrite an existing key. */
+	if (!g_hash_table_lookup (index->by_name, nick))
+		g_hash_table_insert (index->by_name, (gpointer) nick, entry);
+	if (!g_hash_table_lookup (index->by_name, name))
+		g_hash_table_insert (index->by_name, (gpointer) name, entry);
+	if (!g_hash_table_lookup (index->by_value, GINT_TO_POINTER (value)))
+		g_hash_table_insert (index->by_value,
+				     GINT_TO_POINTER (value), entry);
+}
+
+static EnumIndex *
+enum_index_get (GType type)
+{
+	static GQuark quark_enum_index = 0;
+	EnumIndex * index;
+
+	if (!quark_enum_index)
+		quark_enum_index = g_quark_from_static_string
+					("GPerlEnumIndex");
+
+	index = g_type_get_qdata (type, quark_enum_index);
+	if (index)
+		return index;
+
+	G_LOCK (enum_index);
+
+	index = g_type_get_qdata (type, quark_enum_index);
+	if (!index) {
+		guint n = 0;
+
+		if (G_TYPE_IS_ENUM (type)) {
+			GEnumValue * vals = gperl_type_enum_get_values (type);
+			while (vals && vals[n].value_nick && vals[n].value_name)
+				n++;
+			index = g_new0 (EnumIndex, 1);
+			index->entries = g_new0 (EnumEntry, n);
+			index->by_name = g_hash_table_new (gperl_str_hash,
+							   (GEqualFunc) gperl_str_eq);
+			index->by_value = g_hash_table_new (g_direct_hash,
+							    g_direct_equal);
+			for ( ; vals && vals->value_nick && vals->value_name ; vals++)
+				enum_index_add (index, vals->value,
+						vals->value_name, vals->value_nick);
+		} else if (G_TYPE_IS_FLAGS (type)) {
+			GFlagsValue * vals = gperl_type_flags_get_values (type);
+			while (vals && vals[n].value_nick && vals[n].value_name)
+				n++;
+			index = g_new0 (EnumIndex, 1);
+			index->entries = g_new0 (EnumEntry, n);
+			index->by_name = g_hash_table_new (gperl_str_hash,
+							   (GEqualFunc) gperl_str_eq);
+			index->by_value = g_hash_table_new (g_direct_hash,
+							    g_direct_equal);
+			for ( ; vals && vals->value_nick && vals->value_name ; vals++)
+				enum_index_add (index, (gint) vals->value,
+						vals->value_name, vals->value_nick);
+		}
+
+		if (index)
+			g_type_set_qdata (type, quark_enum_index, index);
+	}
+
+	G_UNLOCK (enum_index);
+
+	return index;
+}
+
+/* a new scalar holding the nick, sharing its buffer with perl's string
+ * table. */
+#define ENUM_ENTRY_NICK_SV(entry) \
+	newSVpvn_share ((entry)->nick, (I32) (entry)->nick_len, (entry)->nick_hash)
+
 =item gboolean gperl_try_convert_enum (GType gtype, SV * sv, gint * val)
 
 return FALSE if I<sv> can't be mapped to a valid member of the registered
@@ -325,19 +437,18 @@ gperl_try_convert_enum (GType type,
 			SV * sv,
 			gint * val)
 {
-	GEnumValue * vals;
+	EnumIndex * index;
+	EnumEntry * entry;
 	char *val_p = SvPV_nolen(sv);
 	if (*val_p == '-') val_p++;
-	vals = gperl_type_enum_get_values (type);
-	while (vals && vals->value_nick && vals->value_name) {
-		if (gperl_str_eq (val_p, vals->value_nick) ||
-		    gperl_str_eq (val_p, vals->value_name)) {
-			*val = vals->value;
-			return TRUE;
-		}
-		vals++;
-	}
-	return FALSE;
+	index = enum_index_get (type);
+	if (!index)
+		return FALSE;
+	entry = g_hash_table_lookup (index->by_name, val_p);
+	if (!entry)
+		return FALSE;
+	*val = entry->value;
+	return TRUE;
 }
 
 =item gint gperl_convert_enum (GType type, SV * val)
@@ -387,12 +498,13 @@ SV *
 gperl_convert_back_enum_pass_unknown (GType type,
 				      gint val)
 {
-	GEnumValue * vals = gperl_type_enum_get_values (type);
-	while (vals && vals->value_nick && vals->value_name) {
-		if (vals->value == val)
-			return newSVpv (vals->value_nick, 0);
-		vals++;
-	}
+	EnumIndex * index = enum_index_get (type);
+	EnumEntry * entry = index
+	                  ? g_hash_table_lookup (index->by_value,
+	                                         GINT_TO_POINTER (val))
+	                  : NULL;
+	if (entry)
+		return ENUM_ENTRY_NICK_SV (entry);
 	return newSViv (val);
 }
 
@@ -406,12 +518,13 @@ SV *
 gperl_convert_back_enum (GType type,
 			 gint val)
 {
-	GEnumValue * vals = gperl_type_enum_get_values (type);
-	while (vals && vals->value_nick && vals->value_name) {
-		if (vals->value == val)
-			return newSVpv (vals->value_nick, 0);
-		vals++;
-	}
+	EnumIndex * index = enum_index_get (type);
+	EnumEntry * entry = index
+	                  ? g_hash_table_lookup (index->by_value,
+	                                         GINT_TO_POINTER (val))
+	                  : NULL;
+	if (entry)
+		return ENUM_ENTRY_NICK_SV (entry);
 	croak ("FATAL: could not convert value %d to enum type %s",
 	       val, g_type_name (type));
 	return NULL; /* not reached */
@@ -427,17 +540,14 @@ gperl_try_convert_flag (GType type,
                         const char * val_p,
                         gint * val)
 {
-	GFlagsValue * vals = gperl_type_flags_get_values (type);
-	while (vals && vals->value_nick && vals->value_name) {
-		if (gperl_str_eq (val_p, vals->value_name) ||
-		    gperl_str_eq (val_p, vals->value_nick)) {
-			*val = vals->value;
-			return TRUE;
-		}
-		vals++;
-	}
-
-	return FALSE;
+	EnumIndex * index = enum_index_get (type);
+	EnumEntry * entry = index
+	                  ? g_hash_table_lookup (index->by_name, val_p)
+	                  : NULL;
+	if (!entry)
+		return FALSE;
+	*val = entry->value;
+	return TRUE;
 }
 
 =item gint gperl_convert_flag_one (GType type, const char * val)
@@ -507,14 +617,15 @@ static SV *
 flags_as_arrayref (GType type,
 		   gint val)
 {
-	GFlagsValue * vals = gperl_type_flags_get_values (type);
+	EnumIndex * index = enum_index_get (type);
 	AV * flags = newAV ();
-	while (vals && vals->value_nick && vals->value_name) {
-		if ((val & vals->value) == vals->value) {
-			val -= vals->value;
-			av_push (flags, newSVpv (vals->value_nick, 0));
+	guint i;
+	for (i = 0 ; index && i < index->n_entries ; i++) {
+		EnumEntry * entry = &index->entries[i];
+		if ((val & entry->value) == entry->value) {
+			val -= entry->value;
+			av_push (flags, ENUM_ENTRY_NICK_SV (entry));
 		}
-		vals++;
 	}
 	return newRV_noinc ((SV*) flags);
 }
@@ -913,6 +1024,120 @@ sanitize_package_name (const char * pkg_name)
 	return ctype_name;
 }
 			
+/*
+ * Finding the do_<signal> method for an emission takes a signal query,
+ * building the method name and a method lookup.  Since that's the same for
+ * every emission on a given instance type, the resolved GV is cached per
+ * (instance type, signal id).  Entries are stamped with perl's method cache
+ * generations and thrown away when (re)defining subs or changing @ISA may
+ * have changed the result.  GVs belong to an interpreter, so only the master
+ * interpreter uses the cache.
+ */
+typedef struct {
+	GType  instance_type;
+	guint  signal_id;
+	GV   * gv;  /* NULL if there is no method to call */
+	U32    sub_generation;
+#ifdef HvMROMETA
+	U32    pkg_gen;
+	U32    cache_gen;
+#endif
+} ClassClosureMethod;
+
+static GHashTable * class_closure_methods = NULL;
+G_LOCK_DEFINE_STATIC (class_closure_methods);
+
+static guint
+class_closure_method_hash (gconstpointer key)
+{
+	const ClassClosureMethod * m = key;
+	return (guint) m->instance_type * 31 + m->signal_id;
+}
+
+static gboolean
+class_closure_method_equal (gconstpointer a,
+                            gconstpointer b)
+{
+	const ClassClosureMethod * ma = a, * mb = b;
+	return ma->instance_type == mb->instance_type
+	    && ma->signal_id == mb->signal_id;
+}
+
+static void
+class_closure_method_stamp (ClassClosureMethod * m,
+                            HV * stash)
+{
+	m->sub_generation = PL_sub_generation;
+#ifdef HvMROMETA
+	m->pkg_gen = HvMROMETA (stash)->pkg_gen;
+	m->cache_gen = HvMROMETA (stash)->cache_gen;
+#else
+	PERL_UNUSED_VAR (stash);
+#endif
+}
+
+static gboolean
+class_closure_method_is_current (const ClassClosureMethod * m,
+                                 HV * stash)
+{
+	return m->sub_generation == PL_sub_generation
+#ifdef HvMROMETA
+	    && m->pkg_gen == HvMROMETA (stash)->pkg_gen
+	    && m->cache_gen == HvMROMETA (stash)->cache_gen
+#endif
+	    && (!m->gv || GvCV (m->gv));
+}
+
+/*
+ * Resolve the class closure method for an emission the long way.  Returns
+ * TRUE if the method exists; in that case *gv is the method as seen from
+ * instance_stash, or NULL if it has to be called by name (e.g. because it
+ * would be autoloaded), which is then stored in *method_name.
+ */
+static gboolean
+class_closure_method_resolve (guint signal_id,
+                              HV * instance_stash,
+                              GV ** gv,
+                              SV ** method_name)
+{
+	GSignalQuery query;
+	gchar * tmp;
+	STRLEN i;
+	HV *stash;
+	SV **slot;
+
+	*gv = NULL;
+	*method_name = NULL;
+
+	g_signal_query (signal_id, &query);
+
+	/* construct method name for this class closure */
+	*method_name = newSVpvf ("do_%s", query.signal_name);
+
+	/* convert dashes to underscores.  g_signal_name converts all the
+	 * underscores in the signal name to dashes, but dashes are not
+	 * valid in subroutine names. */
+	for (tmp = SvPV_nolen (*method_name); *tmp != '\0'; tmp++)
+		if (*tmp == '-') *tmp = '_';
+
+	/* the method has to exist in the package that defines the signal,
+	 * but it is called as a method on the instance, so subclasses may
+	 * override it. */
+	stash = gperl_object_stash_from_type (query.itype);
+	assert (stash);
+	tmp = SvPV (*method_name, i);
+	slot = hv_fetch (stash, tmp, i, 0);
+	if (!slot || !GvCV (*slot))
+		return FALSE;
+
+	if (instance_stash)
+		*gv = gv_fetchmethod_autoload (instance_stash, tmp, FALSE);
+	if (*gv && !GvCV (*gv))
+		*gv = NULL;
+
+	return TRUE;
+}
+
 static void
 gperl_signal_class_closure_marshal (GClosure *closure,
 				    GValue *return_value,
@@ -922,12 +1147,13 @@ gperl_signal_class_closure_marshal (GClosure *closure,
 				    gpointer marshal_data)
 {
 	GSignalInvocationHint *hint = (GSignalInvocationHint *)invocation_hint;
-	GSignalQuery query;
-	gchar * tmp;
-	SV * method_name;
-	STRLEN i;
-	HV *stash;
-	SV **slot;
+	ClassClosureMethod key, * cached = NULL;
+	HV * instance_stash = NULL;
+	SV * instance_sv;
+	SV * method_name = NULL;
+	GV * gv = NULL;
+	gboolean found;
+	guint i;
 	/* see GClosure.xs and gperl_marshal.h for an explanation.  we can't
 	 * use that code because this is a different style of closure, but we
 	 * need to emulate it very closely. */
@@ -942,25 +1168,65 @@ gperl_signal_class_closure_marshal (GClosure *closure,
 	warn ("gperl_signal_class_closure_marshal");
 #endif
 	g_return_if_fail(invocation_hint != NULL);
+	g_assert (n_param_values != 0);
+
+	key.instance_type = G_TYPE_FROM_INSTANCE
+		(g_value_peek_pointer ((GValue *) &param_values[0]));
+	key.signal_id = hint->signal_id;
+	if (G_TYPE_IS_OBJECT (key.instance_type))
+		instance_stash = gperl_object_stash_from_type (key.instance_type);
+
+	/* the method is called on the wrapper, which may have been blessed
+	 * into some other package than the registered one.  the cache is
+	 * keyed on the registered type, so then look the method up by name. */
+	instance_sv = gperl_sv_from_value ((GValue *) &param_values[0]);
+	if (instance_stash
+	    && (!gperl_sv_is_ref (instance_sv)
+	        || !SvOBJECT (SvRV (instance_sv))
+	        || SvSTASH (SvRV (instance_sv)) != instance_stash))
+		instance_stash = NULL;
+
+	if (instance_stash
+#ifdef PERL_IMPLICIT_CONTEXT
+	    && aTHX == _gperl_get_master_interp ()
+#endif
+	   ) {
+		G_LOCK (class_closure_methods);
+		if (!class_closure_methods)
+			class_closure_methods = g_hash_table_new_full
+				(class_closure_method_hash,
+				 class_closure_method_equal,
+				 NULL, g_free);
+		cached = g_hash_table_lookup (class_closure_methods, &key);
+		G_UNLOCK (class_closure_methods);
+	}
 
-	g_signal_query (hint->signal_id, &query);
-
-	/* construct method name for this class closure */
-	method_name = newSVpvf ("do_%s", query.signal_name);
-
-	/* convert dashes to underscores.  g_signal_name converts all the
-	 * underscores in the signal name to dashes, but dashes are not
-	 * valid in subroutine names. */
-	for (tmp = SvPV_nolen (method_name); *tmp != '\0'; tmp++)
-		if (*tmp == '-') *tmp = '_';
-
-	stash = gperl_object_stash_from_type (query.itype);
-	assert (stash);
-	tmp = SvPV (method_name, i);
-	slot = hv_fetch (stash, tmp, i, 0);
+	if (cached && class_closure_method_is_current (cached, instance_stash)) {
+		gv = cached->gv;
+		found = gv != NULL;
+	} else {
+		found = class_closure_method_resolve (hint->signal_id,
+		                                      instance_stash,
+		                                      &gv, &method_name);
+		/* only cache what can be called directly */
+		if (instance_stash
+#ifdef PERL_IMPLICIT_CONTEXT
+		    && aTHX == _gperl_get_master_interp ()
+#endif
+		    && (!found || gv)) {
+			ClassClosureMethod * m = g_new (ClassClosureMethod, 1);
+			*m = key;
+			m->gv = gv;
+			class_closure_method_stamp (m, instance_stash);
+			G_LOCK (class_closure_methods);
+			/* replaces (and frees) any stale entry */
+			g_hash_table_replace (class_closure_methods, m, m);
+			G_UNLOCK (class_closure_methods);
+		}
+	}
 
 	/* does the function exist? then call it. */
-	if (slot && GvCV (*slot)) {
+	if (found) {
 		SV * save_errsv;
 		gboolean want_return_value;
 		int flags;
@@ -971,13 +1237,12 @@ gperl_signal_class_closure_marshal (GClosure *closure,
 
 		PUSHMARK (SP);
 
-		g_assert (n_param_values != 0);
-
 		/* watch very carefully the reference counts on the scalar
 		 * object references, or else we can get indestructible
 		 * objects. */
 		EXTEND (SP, (int)n_param_values);
-		for (i = 0; i < n_param_values; i++)
+		PUSHs (sv_2mortal (instance_sv));
+		for (i = 1; i < n_param_values; i++)
 			SAVED_STACK_PUSHs (sv_2mortal (gperl_sv_from_value
 						((GValue*) &param_values[i])));
 
@@ -989,7 +1254,10 @@ gperl_signal_class_closure_marshal (GClosure *closure,
 		save_errsv = sv_2mortal (newSVsv (ERRSV));
 		want_return_value = return_value && G_VALUE_TYPE (return_value);
 		flags = G_EVAL | (want_return_value ? G_SCALAR : G_VOID|G_DISCARD);
-		call_method (SvPV_nolen (method_name), flags);
+		if (gv)
+			call_sv ((SV *) GvCV (gv), flags);
+		else
+			call_method (SvPV_nolen (method_name), flags);
 		SPAGAIN;
 		if (SvTRUE (ERRSV)) {
 			gperl_run_exception_handlers ();
@@ -1002,9 +1270,12 @@ gperl_signal_class_closure_marshal (GClosure *closure,
 
 		FREETMPS;
 		LEAVE;
+	} else {
+		SvREFCNT_dec (instance_sv);
 	}
 
-	SvREFCNT_dec (method_name);
+	if (method_name)
+		SvREFCNT_dec (method_name);
 }
 
 /**
@@ -1142,6 +1413,204 @@ gperl_real_signal_accumulator (GSignalInvocationHint *ihint,
 	return retval;
 }
 
+/*
+ * Built-in accumulators, for the common cases that don't need a perl sub.
+ * They are selected with the Glib::Signal::ACCUMULATE_* constants in the
+ * signal hash and run entirely in C.  Where GLib has one of its own, we
+ * use that.
+ */
+
+#if GLIB_CHECK_VERSION (2, 28, 0)
+# define gperl_accumulator_first_wins g_signal_accumulator_first_wins
+#else
+/* the first handler's return value wins; later handlers don't run. */
+static gboolean
+gperl_accumulator_first_wins (GSignalInvocationHint *ihint,
+                              GValue *return_accu,
+                              const GValue *handler_return,
+                              gpointer data)
+{
+	PERL_UNUSED_VAR (ihint);
+	PERL_UNUSED_VAR (data);
+	g_value_copy (handler_return, return_accu);
+	return FALSE;
+}
+#endif
+
+#if GLIB_CHECK_VERSION (2, 4, 0)
+# define gperl_accumulator_true_handled g_signal_accumulator_true_handled
+#else
+/* boolean; stop at the first handler that returns TRUE, like gtk's
+ * event signals. */
+static gboolean
+gperl_accumulator_true_handled (GSignalInvocationHint *ihint,
+                                GValue *return_accu,
+                                const GValue *handler_return,
+                                gpointer data)
+{
+	gboolean handled = g_value_get_boolean (handler_return);
+	PERL_UNUSED_VAR (ihint);
+	PERL_UNUSED_VAR (data);
+	g_value_set_boolean (return_accu, handled);
+	return !handled;
+}
+#endif
+
+/* boolean; TRUE if any handler returned TRUE.  all handlers run. */
+static gboolean
+gperl_accumulator_logical_or (GSignalInvocationHint *ihint,
+                              GValue *return_accu,
+                              const GValue *handler_return,
+                              gpointer data)
+{
+	PERL_UNUSED_VAR (ihint);
+	PERL_UNUSED_VAR (data);
+	if (g_value_get_boolean (handler_return))
+		g_value_set_boolean (return_accu, TRUE);
+	return TRUE;
+}
+
+/* numbers; the sum of all handlers' return values. */
+static gboolean
+gperl_accumulator_sum (GSignalInvocationHint *ihint,
+                       GValue *return_accu,
+                       const GValue *handler_return,
+                       gpointer data)
+{
+	PERL_UNUSED_VAR (ihint);
+	PERL_UNUSED_VAR (data);
+	switch (G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (return_accu))) {
+#define ADD(type)						\
+		g_value_set_##type (return_accu,			\
+		                    g_value_get_##type (return_accu)	\
+		                    + g_value_get_##type (handler_return));	\
+		break;
+	    case G_TYPE_INT:	ADD (int)
+	    case G_TYPE_UINT:	ADD (uint)
+	    case G_TYPE_LONG:	ADD (long)
+	    case G_TYPE_ULONG:	ADD (ulong)
+	    case G_TYPE_INT64:	ADD (int64)
+	    case G_TYPE_UINT64:	ADD (uint64)
+	    case G_TYPE_FLOAT:	ADD (float)
+	    case G_TYPE_DOUBLE:	ADD (double)
+#undef ADD
+	    default:
+		g_assert_not_reached ();
+	}
+	return TRUE;
+}
+
+/* Glib::Scalar; a reference to an array of all handlers' return values. */
+static gboolean
+gperl_accumulator_collect (GSignalInvocationHint *ihint,
+                           GValue *return_accu,
+                           const GValue *handler_return,
+                           gpointer data)
+{
+	SV * accu = g_value_get_boxed (return_accu);
+	SV * item = g_value_get_boxed (handler_return);
+	PERL_UNUSED_VAR (ihint);
+	PERL_UNUSED_VAR (data);
+	if (!gperl_sv_is_array_ref (accu)) {
+		SV * rv = newRV_noinc ((SV *) newAV ());
+		g_value_set_boxed (return_accu, rv);
+		SvREFCNT_dec (rv);
+		accu = g_value_get_boxed (return_accu);
+	}
+	/* a handler that returned undef leaves no boxed value at all; it
+	 * still gets its slot. */
+	av_push ((AV *) SvRV (accu), item ? newSVsv (item) : newSV (0));
+	return TRUE;
+}
+
+static gboolean
+return_type_is_boolean (GType type)
+{
+	return type == G_TYPE_BOOLEAN;
+}
+
+static gboolean
+return_type_is_number (GType type)
+{
+	switch (G_TYPE_FUNDAMENTAL (type)) {
+	    case G_TYPE_INT:
+	    case G_TYPE_UINT:
+	    case G_TYPE_LONG:
+	    case G_TYPE_ULONG:
+	    case G_TYPE_INT64:
+	    case G_TYPE_UINT64:
+	    case G_TYPE_FLOAT:
+	    case G_TYPE_DOUBLE:
+		return TRUE;
+	    default:
+		return FALSE;
+	}
+}
+
+static gboolean
+return_type_is_scalar (GType type)
+{
+	return type == GPERL_TYPE_SV;
+}
+
+static gboolean
+return_type_is_any (GType type)
+{
+	return type != G_TYPE_NONE;
+}
+
+static const struct {
+	const char         * name;
+	GSignalAccumulator   accumulator;
+	gboolean          (* check_return_type) (GType type);
+	const char         * return_types;
+} builtin_accumulators[] = {
+	{ "first-wins",   gperl_accumulator_first_wins,
+	                  return_type_is_any,     "any type" },
+	{ "true-handled", gperl_accumulator_true_handled,
+	                  return_type_is_boolean, "Glib::Boolean" },
+	{ "logical-or",   gperl_accumulator_logical_or,
+	                  return_type_is_boolean, "Glib::Boolean" },
+	{ "sum",          gperl_accumulator_sum,
+	                  return_type_is_number,  "a numeric type" },
+	{ "collect",      gperl_accumulator_collect,
+	                  return_type_is_scalar,  "Glib::Scalar" },
+};
+
+/* look up the built-in accumulator selected by one of the
+ * Glib::Signal::ACCUMULATE_* constants; returns NULL for anything else, so
+ * that plain strings keep naming perl subs.  croaks if the signal's return
+ * type doesn't fit. */
+static GSignalAccumulator
+find_builtin_accumulator (SV * sv,
+                          const char * signal_name,
+                          GType return_type)
+{
+	const char * name;
+	guint i;
+
+	if (!gperl_sv_is_ref (sv) || !sv_derived_from (sv, "Glib::Signal::Accumulator"))
+		return NULL;
+
+	name = SvPV_nolen (SvRV (sv));
+	for (i = 0 ; i < G_N_ELEMENTS (builtin_accumulators) ; i++) {
+		if (strEQ (name, builtin_accumulators[i].name)) {
+			if (!builtin_accumulators[i].check_return_type (return_type))
+				croak ("the %s accumulator needs a return type "
+				       "of %s, but signal %s returns %s",
+				       builtin_accumulators[i].name,
+				       builtin_accumulators[i].return_types,
+				       signal_name,
+				       return_type == G_TYPE_NONE
+				       ? "nothing"
+				       : g_type_name (return_type));
+			return builtin_accumulators[i].accumulator;
+		}
+	}
+	croak ("%s is not a known built-in accumulator", name);
+	return NULL; /* not reached */
+}
+
 /*
 parse a hash describing a new signal into a SignalParams struct.
 
@@ -1178,7 +1647,6 @@ parse_signal_hash (GType instance_type,
 	SV ** svp;
 
 	PERL_UNUSED_VAR (instance_type);
-	PERL_UNUSED_VAR (signal_name);
 
 	svp = hv_fetch (hv, "flags", 5, FALSE);
 	if (svp && gperl_sv_is_defined (*svp))
@@ -1222,10 +1690,17 @@ parse_signal_hash (GType instance_type,
 	svp = hv_fetch (hv, "accumulator", 11, FALSE);
 	if (svp && *svp) {
 		SV * func = *svp;
-		svp = hv_fetch (hv, "accu_data", 9, FALSE);
-		s->accumulator = gperl_real_signal_accumulator;
-		s->accu_data = gperl_callback_new (func, svp ? *svp : NULL,
-		                                   0, NULL, 0);
+		/* one of the Glib::Signal::ACCUMULATE_* constants selects a
+		 * built-in accumulator; anything else is a perl sub or the
+		 * name of one, as before. */
+		s->accumulator = find_builtin_accumulator
+			(func, signal_name, s->return_type);
+		if (!s->accumulator) {
+			svp = hv_fetch (hv, "accu_data", 9, FALSE);
+			s->accumulator = gperl_real_signal_accumulator;
+			s->accu_data = gperl_callback_new
+				(func, svp ? *svp : NULL, 0, NULL, 0);
+		}
 	}
 
 	return s;
@@ -1428,9 +1903,11 @@ prop_handler_lookup (GType instance_type,
 }
 
 static void
-add_properties (GType instance_type, GObjectClass * oclass, AV * properties)
+add_properties (GType instance_type, GObjectClass * oclass, AV * properties,
+                gboolean use_slots)
 {
 	int propid;
+	guint first_slot = property_slot_count (g_type_parent (instance_type));
 
 	for (propid = 0; propid <= av_len (properties); propid++) {
 		SV * sv = *av_fetch (properties, propid, 1);
@@ -1468,6 +1945,10 @@ add_properties (GType instance_type, GObjectClass * oclass, AV * properties)
 			       gperl_format_variable_for_output (sv),
 			       gperl_object_package_from_type (instance_type));
 		}
+		if (use_slots)
+			g_param_spec_set_qdata
+				(pspec, property_slot_quark (),
+				 GUINT_TO_POINTER (first_slot + propid + 1));
 		g_object_class_install_property (oclass, propid + 1, pspec);
 	}
 }
@@ -1555,14 +2036,218 @@ add_interfaces (GType instance_type, AV * interfaces)
 }
 
 
+/*
+ * The ALLCAPS methods perl types may implement -- GET_PROPERTY and friends
+ * -- are looked up in the type's own package (no inheritance) on every
+ * property access, construction and destruction.  Cache the GVs per type,
+ * stamped with the package's generation, so that (re)defining or removing
+ * one of them is noticed.  GVs belong to an interpreter, so only the master
+ * interpreter uses the cache.
+ */
+typedef enum {
+	PERL_VFUNC_GET_PROPERTY,
+	PERL_VFUNC_SET_PROPERTY,
+	PERL_VFUNC_INIT_INSTANCE,
+	PERL_VFUNC_FINALIZE_INSTANCE,
+	PERL_VFUNC_N
+} PerlVFunc;
+
+static const struct {
+	const char * name;
+	I32 len;
+} perl_vfunc_names[PERL_VFUNC_N] = {
+#define NAME(n) { n, sizeof (n) - 1 }
+	NAME ("GET_PROPERTY"),
+	NAME ("SET_PROPERTY"),
+	NAME ("INIT_INSTANCE"),
+	NAME ("FINALIZE_INSTANCE"),
+#undef NAME
+};
+
+typedef struct {
+	HV * stash;
+	GV * gvs[PERL_VFUNC_N]; /* reffed; NULL if not defined */
+	U32  sub_generation;
+#ifdef HvMROMETA
+	U32  pkg_gen;
+#endif
+} PerlVFuncCache;
+
+static GQuark
+perl_vfunc_cache_quark (void)
+{
+	static GQuark q = 0;
+	if (!q)
+		q = g_quark_from_static_string ("GPerlVFuncCache");
+	return q;
+}
+
+static GV *
+perl_vfunc_fetch (HV * stash,
+                  PerlVFunc which)
+{
+	SV ** slot = hv_fetch (stash, perl_vfunc_names[which].name,
+	                       perl_vfunc_names[which].len, 0);
+	return slot && isGV (*slot) && GvCV (*slot) ? (GV *) *slot : NULL;
+}
+
+/* returns the type's own implementation of the method, or NULL. */
+static CV *
+perl_vfunc_lookup (GType type,
+                   PerlVFunc which)
+{
+	PerlVFuncCache * cache;
+	HV * stash;
+	int i;
+
+#ifdef PERL_IMPLICIT_CONTEXT
+	if (aTHX != _gperl_get_master_interp ()) {
+		GV * gv;
+		stash = gperl_object_stash_from_type (type);
+		assert (stash);
+		gv = perl_vfunc_fetch (stash, which);
+		return gv ? GvCV (gv) : NULL;
+	}
+#endif
+
+	cache = g_type_get_qdata (type, perl_vfunc_cache_quark ());
+	if (cache
+	    && cache->sub_generation == PL_sub_generation
+#ifdef HvMROMETA
+	    && cache->pkg_gen == HvMROMETA (cache->stash)->pkg_gen
+#endif
+	   ) {
+		GV * gv = cache->gvs[which];
+		return gv ? GvCV (gv) : NULL;
+	}
+
+	stash = gperl_object_stash_from_type (type);
+	assert (stash);
+	if (!cache) {
+		cache = g_new0 (PerlVFuncCache, 1);
+		g_type_set_qdata (type, perl_vfunc_cache_quark (), cache);
+	}
+	cache->stash = stash;
+	for (i = 0 ; i < PERL_VFUNC_N ; i++) {
+		GV * gv = perl_vfunc_fetch (stash, i);
+		if (gv)
+			SvREFCNT_inc (gv);
+		if (cache->gvs[i])
+			SvREFCNT_dec (cache->gvs[i]);
+		cache->gvs[i] = gv;
+	}
+	cache->sub_generation = PL_sub_generation;
+#ifdef HvMROMETA
+	cache->pkg_gen = HvMROMETA (stash)->pkg_gen;
+#endif
+
+	return cache->gvs[which] ? GvCV (cache->gvs[which]) : NULL;
+}
+
+/*
+ * Slot storage for properties.  Types registered with
+ * "property_storage => 'slots'" give each of their properties a fixed
+ * index, stored on the GParamSpec, and their instances keep the values of
+ * such properties in an array of SVs, instead of under the property's name
+ * in the wrapper hash.  Indices are unique along a class hierarchy: each
+ * perl type records the number of slots used by itself and its ancestors,
+ * and a subclass' slots start after its parent's.
+ */
+typedef struct {
+	guint n_slots;
+	SV * slots[1];
+} PropertySlots;
+
+static GQuark
+property_slot_quark (void)
+{
+	static GQuark q = 0;
+	if (!q)
+		q = g_quark_from_static_string ("GPerlPropertySlot");
+	return q;
+}
+
+static GQuark
+property_slot_count_quark (void)
+{
+	static GQuark q = 0;
+	if (!q)
+		q = g_quark_from_static_string ("GPerlPropertySlotCount");
+	return q;
+}
+
+static GQuark
+property_slots_quark (void)
+{
+	static GQuark q = 0;
+	if (!q)
+		q = g_quark_from_static_string ("GPerlPropertySlots");
+	return q;
+}
+
+/* number of slots used by type and its ancestors.  the count is stored +1,
+ * so that types without any record can be told apart. */
+static guint
+property_slot_count (GType type)
+{
+	for ( ; type != 0 ; type = g_type_parent (type)) {
+		gpointer count = g_type_get_qdata (type,
+		                                   property_slot_count_quark ());
+		if (count)
+			return GPOINTER_TO_UINT (count) - 1;
+	}
+	return 0;
+}
+
+static void
+property_slots_free (PropertySlots * slots)
+{
+	guint i;
+	GPERL_SET_CONTEXT;
+	for (i = 0 ; i < slots->n_slots ; i++)
+		if (slots->slots[i])
+			SvREFCNT_dec (slots->slots[i]);
+	g_free (slots);
+}
+
+/* find the slot for pspec on object.  returns NULL if pspec has no slot,
+ * or, unless create is TRUE, if the object has no storage yet. */
+static SV **
+property_slot_fetch (GObject * object,
+                     GParamSpec * pspec,
+                     gboolean create)
+{
+	guint index = GPOINTER_TO_UINT
+		(g_param_spec_get_qdata (pspec, property_slot_quark ()));
+	PropertySlots * slots;
+
+	if (!index--)
+		return NULL;
+
+	slots = g_object_get_qdata (object, property_slots_quark ());
+	if (!slots) {
+		guint n_slots;
+		if (!create)
+			return NULL;
+		n_slots = property_slot_count (G_OBJECT_TYPE (object));
+		g_assert (index < n_slots);
+		slots = g_malloc0 (sizeof (PropertySlots)
+		                   + (n_slots - 1) * sizeof (SV *));
+		slots->n_slots = n_slots;
+		g_object_set_qdata_full (object, property_slots_quark (), slots,
+		                         (GDestroyNotify) property_slots_free);
+	}
+
+	return &slots->slots[index];
+}
+
 static void
 gperl_type_get_property (GObject * object,
 		 guint property_id,
 		 GValue * value,
 		 GParamSpec * pspec)
 {
-	HV *stash;
-	SV **slot;
+	CV * get_property;
 	SV * getter;
 
 	prop_handler_lookup (pspec->owner_type, property_id, NULL, &getter);
@@ -1582,12 +2267,11 @@ gperl_type_get_property (GObject * object,
 		return;
 	}
 
-	stash = gperl_object_stash_from_type (pspec->owner_type);
-	assert (stash);
-	slot = hv_fetch (stash, "GET_PROPERTY", sizeof ("GET_PROPERTY") - 1, 0);
+	get_property = perl_vfunc_lookup (pspec->owner_type,
+	                                  PERL_VFUNC_GET_PROPERTY);
 
 	/* does the function exist? then call it. */
-	if (slot && GvCV (*slot)) {
+	if (get_property) {
 		  dSP;
 
 		  ENTER;
@@ -1598,8 +2282,9 @@ gperl_type_get_property (GObject * object,
 		  XPUSHs (sv_2mortal (newSVGParamSpec (pspec)));
 		  PUTBACK;
 
-		  if (1 != call_sv ((SV *)GvCV (*slot), G_SCALAR))
-			  croak ("%s->GET_PROPERTY didn't return exactly one value", HvNAME (stash));
+		  if (1 != call_sv ((SV *) get_property, G_SCALAR))
+			  croak ("%s->GET_PROPERTY didn't return exactly one value",
+			         gperl_object_package_from_type (pspec->owner_type));
 
 		  SPAGAIN;
 
@@ -1610,8 +2295,14 @@ gperl_type_get_property (GObject * object,
 		  LEAVE;
 
 	} else {
-		/* no GET_PROPERTY; look in the wrapper hash. */
-		SV * val = _gperl_fetch_wrapper_key
+		/* no GET_PROPERTY; look in the property's slot, or in the
+		 * wrapper hash. */
+		SV ** cell = property_slot_fetch (object, pspec, FALSE);
+		SV * val = cell
+		         ? *cell
+		         : g_param_spec_get_qdata (pspec, property_slot_quark ())
+		         ? NULL
+		         : _gperl_fetch_wrapper_key
 				(object, g_param_spec_get_name (pspec), FALSE);
 		if (val)
 			gperl_value_from_sv (value, val);
@@ -1629,8 +2320,7 @@ gperl_type_set_property (GObject * object,
                          const GValue * value,
                          GParamSpec * pspec)
 {
-	HV  * stash;
-	SV ** slot;
+	CV  * set_property;
 	SV  * setter;
 
 	prop_handler_lookup (pspec->owner_type, property_id, &setter, NULL);
@@ -1649,12 +2339,11 @@ gperl_type_set_property (GObject * object,
 		return;
 	}
 
-	stash = gperl_object_stash_from_type (pspec->owner_type);
-	assert (stash);
-	slot = hv_fetch (stash, "SET_PROPERTY", sizeof ("SET_PROPERTY") - 1, 0);
+	set_property = perl_vfunc_lookup (pspec->owner_type,
+	                                  PERL_VFUNC_SET_PROPERTY);
 
 	/* does the function exist? then call it. */
-	if (slot && GvCV (*slot)) {
+	if (set_property) {
 		  dSP;
 
 		  ENTER;
@@ -1666,15 +2355,23 @@ gperl_type_set_property (GObject * object,
 		  SAVED_STACK_XPUSHs (sv_2mortal (gperl_sv_from_value (value)));
 		  PUTBACK;
 
-		  call_sv ((SV *)GvCV (*slot), G_VOID|G_DISCARD);
+		  call_sv ((SV *) set_property, G_VOID|G_DISCARD);
 
 		  FREETMPS;
 		  LEAVE;
 
 	} else {
 		/* no SET_PROPERTY.  fall back to setting the value into
-		 * a key with the pspec's name in the wrapper hash. */
-		SV * val = _gperl_fetch_wrapper_key
+		 * the property's slot, or a key with the pspec's name in the
+		 * wrapper hash. */
+		SV ** cell = property_slot_fetch (object, pspec, TRUE);
+		SV * val;
+		if (cell) {
+			if (!*cell)
+				*cell = newSV (0);
+			val = *cell;
+		} else
+			val = _gperl_fetch_wrapper_key
 				(object, g_param_spec_get_name (pspec), TRUE);
 		if (val) {
 			SV * newval = sv_2mortal (gperl_sv_from_value (value));
@@ -1707,13 +2404,14 @@ gperl_type_finalize (GObject * instance)
 		/* call finalize for each perl class and the topmost non-perl class */
 		if (class->finalize == gperl_type_finalize) {
 			if (!PL_in_clean_objs) {
-				HV *stash = gperl_object_stash_from_type (G_TYPE_FROM_CLASS (class));
-				SV **slot = hv_fetch (stash, "FINALIZE_INSTANCE", sizeof ("FINALIZE_INSTANCE") - 1, 0);
+				CV *finalize_instance = perl_vfunc_lookup
+					(G_TYPE_FROM_CLASS (class),
+					 PERL_VFUNC_FINALIZE_INSTANCE);
 
 				instance->ref_count += 2; /* HACK: temporarily revive the object. */
 
 				/* does the function exist? then call it. */
-				if (slot && GvCV (*slot)) {
+				if (finalize_instance) {
 					  dSP;
 
 					  ENTER;
@@ -1723,7 +2421,7 @@ gperl_type_finalize (GObject * instance)
 					  XPUSHs (sv_2mortal (gperl_new_object (instance, FALSE)));
 					  PUTBACK;
 
-					  call_sv ((SV *)GvCV (*slot), G_VOID|G_DISCARD);
+					  call_sv ((SV *) finalize_instance, G_VOID|G_DISCARD);
 
 					  FREETMPS;
 					  LEAVE;
@@ -1752,7 +2450,7 @@ gperl_type_instance_init (GObject * instance, gpointer g_class)
 	 */
 	SV *obj;
 	HV *stash = gperl_object_stash_from_type (G_OBJECT_TYPE (instance));
-	SV **slot;
+	CV *init_instance;
 	g_assert (stash != NULL);
 
 	PERL_UNUSED_VAR (g_class);
@@ -1784,7 +2482,8 @@ gperl_type_instance_init (GObject * instance, gpointer g_class)
 	sv_bless (obj, stash);
 
 	/* get the INIT_INSTANCE sub from this package. */
-	slot = hv_fetch (stash, "INIT_INSTANCE", sizeof ("INIT_INSTANCE") - 1, 0);
+	init_instance = perl_vfunc_lookup (G_OBJECT_TYPE (instance),
+	                                   PERL_VFUNC_INIT_INSTANCE);
 
 #ifdef NOISY
 	warn ("gperl_type_instance_init	 %s (%p) => %s\n",
@@ -1792,14 +2491,14 @@ gperl_type_instance_init (GObject * instance, gpointer g_class)
 #endif
 
 	/* does the function exist? then call it. */
-	if (slot && GvCV (*slot)) {
+	if (init_instance) {
 		dSP;
 		ENTER;
 		SAVETMPS;
 		PUSHMARK (SP);
 		XPUSHs (obj);
 		PUTBACK;
-		call_sv ((SV *)GvCV (*slot), G_VOID|G_DISCARD);
+		call_sv ((SV *) init_instance, G_VOID|G_DISCARD);
 		FREETMPS;
 		LEAVE;
 	}
@@ -1820,18 +2519,29 @@ typedef struct {
 	AV *interfaces;
 	AV *properties;
 	HV *signals;
+	gboolean slot_storage;
 } GPerlClassData;
 
 static void
 gperl_type_class_init (GObjectClass * class, GPerlClassData * class_data)
 {
+	guint n_slots = property_slot_count
+			(g_type_parent (class_data->instance_type));
+
 	class->finalize     = gperl_type_finalize;
 	class->get_property = gperl_type_get_property;
 	class->set_property = gperl_type_set_property;
 
-	if (class_data->properties)
+	if (class_data->properties) {
 		add_properties (class_data->instance_type, class,
-		                class_data->properties);
+		                class_data->properties,
+		                class_data->slot_storage);
+		if (class_data->slot_storage)
+			n_slots += av_len (class_data->properties) + 1;
+	}
+	g_type_set_qdata (class_data->instance_type,
+	                  property_slot_count_quark (),
+	                  GUINT_TO_POINTER (n_slots + 1));
 	if (class_data->signals)
 		add_signals (class_data->instance_type,
 		             class_data->signals, class_data->interfaces);
@@ -2149,13 +2859,15 @@ actually means instance and maybe data.
 Flags describing this signal's properties. See the GObject C API reference'
 description of GSignalFlags for a complete description.
 
-=item accumulator => subroutine or undef
+=item accumulator => subroutine, name, built-in or undef
 
 The signal accumulator is a special callback that can be used to collect return
 values of the various callbacks that are called during a signal emission.
 Generally, you can omit this parameter; custom accumulators are used to do
 things like stopping signal propagation by return value or creating a list of
-returns, etc.  See L<Glib::Object::Subclass/SIGNALS> for details.
+returns, etc.  The common cases are built in and may be selected with the
+Glib::Signal::ACCUMULATE_* constants; see L<Glib::Object::Subclass/SIGNALS>
+for details.
 
 =back
 
@@ -2211,6 +2923,17 @@ ALLCAPS methods will automatically be called whenever needed.  Which methods
 exactly depends on the interface -- Gtk2::CellEditable for example uses
 START_EDITING, EDITING_DONE, and REMOVE_WIDGET.
 
+=item property_storage => 'hash' or 'slots'
+
+Where the fallback GET_PROPERTY and SET_PROPERTY keep the values of the new
+type's properties.  With 'hash', the default, they live in the object's
+hash under the property's name.  With 'slots', each property gets a fixed
+slot in a small array attached to the object; getting and setting such
+properties then involves no hashing or key mangling, but the values are
+only accessible through C<get> and C<set>, not as C<< $self->{name} >>.
+This has no effect on properties with their own getter or setter, or if
+the package defines GET_PROPERTY or SET_PROPERTY.
+
 =back
 
 =cut
@@ -2297,6 +3020,12 @@ g_type_register_object (class, parent_package, new_package, ...);
 				class_data.interfaces = (AV*)SvRV (ST (i+1));
 			else
 				croak ("interfaces must be an array of package names");
+		} else if (strEQ (key, "property_storage")) {
+			const char * storage = SvPV_nolen (ST (i+1));
+			if (strEQ (storage, "slots"))
+				class_data.slot_storage = TRUE;
+			else if (!strEQ (storage, "hash"))
+				croak ("property_storage must be 'hash' or 'slots'");
 		}
 	}
 
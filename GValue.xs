@@ -34,6 +34,7 @@ arrays and the like.
 =cut
 
 #include "gperl.h"
+#include "gperl-private.h" /* for GPerlValueConverter */
 
 
 /****************************************************************************
@@ -163,7 +164,8 @@ gperl_value_from_sv (GValue * value,
 		default: {
 			GPerlValueWrapperClass *wrapper_class;
 
-			wrapper_class = gperl_fundamental_wrapper_class_from_type (type);
+			wrapper_class = _gperl_value_converter_lookup
+						(G_VALUE_TYPE (value))->wrapper_class;
 			if (wrapper_class && wrapper_class->unwrap) {
 				wrapper_class->unwrap (value, sv);
 				break;
@@ -301,7 +303,8 @@ _gperl_sv_from_value_internal (const GValue * value,
 		default: {
 			GPerlValueWrapperClass *wrapper_class;
 
-			wrapper_class = gperl_fundamental_wrapper_class_from_type (type);
+			wrapper_class = _gperl_value_converter_lookup
+						(G_VALUE_TYPE (value))->wrapper_class;
 			if (wrapper_class && wrapper_class->wrap)
 				return wrapper_class->wrap (value);
 
@@ -330,6 +333,255 @@ gperl_sv_from_value (const GValue * value)
 	return _gperl_sv_from_value_internal (value, FALSE);
 }
 
+
+/****************************************************************************
+ * resolved converters
+ *
+ * the generic functions above have to work out what to do from scratch for
+ * every value, which for objects, boxed types, enums and the like includes
+ * hash lookups.  _gperl_value_converter_lookup resolves all of that once
+ * per concrete GType and remembers the result in the type's qdata.  simple
+ * fundamentals, for which the switch is as good as it gets, and types we
+ * don't know how to handle (yet) get the generic converter.
+ */
+
+static void
+generic_from_sv (const GPerlValueConverter * converter,
+		 GValue * value,
+		 SV * sv)
+{
+	PERL_UNUSED_VAR (converter);
+	gperl_value_from_sv (value, sv);
+}
+
+static SV *
+generic_to_sv (const GPerlValueConverter * converter,
+	       const GValue * value,
+	       gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (converter);
+	return _gperl_sv_from_value_internal (value, copy_boxed);
+}
+
+static void
+object_from_sv (const GPerlValueConverter * converter,
+		GValue * value,
+		SV * sv)
+{
+	g_value_set_object (value, gperl_get_object_check (sv, converter->gtype));
+}
+
+static void
+interface_from_sv (const GPerlValueConverter * converter,
+		   GValue * value,
+		   SV * sv)
+{
+	PERL_UNUSED_VAR (converter);
+	g_value_set_object (value, gperl_get_object (sv));
+}
+
+static SV *
+object_to_sv (const GPerlValueConverter * converter,
+	      const GValue * value,
+	      gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (converter);
+	PERL_UNUSED_VAR (copy_boxed);
+	return gperl_new_object (g_value_get_object (value), FALSE);
+}
+
+static void
+boxed_from_sv (const GPerlValueConverter * converter,
+	       GValue * value,
+	       SV * sv)
+{
+	g_value_set_static_boxed (value,
+				  gperl_get_boxed_check (sv, converter->gtype));
+}
+
+static SV *
+boxed_to_sv (const GPerlValueConverter * converter,
+	     const GValue * value,
+	     gboolean copy_boxed)
+{
+	return copy_boxed
+	     ? gperl_new_boxed_copy (g_value_get_boxed (value),
+				     converter->gtype)
+	     : gperl_new_boxed (g_value_get_boxed (value),
+				converter->gtype, FALSE);
+}
+
+static void
+perl_sv_from_sv (const GPerlValueConverter * converter,
+		 GValue * value,
+		 SV * sv)
+{
+	PERL_UNUSED_VAR (converter);
+	g_value_set_boxed (value, gperl_sv_is_defined (sv) ? sv : NULL);
+}
+
+static SV *
+perl_sv_to_sv (const GPerlValueConverter * converter,
+	       const GValue * value,
+	       gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (converter);
+	PERL_UNUSED_VAR (copy_boxed);
+	return g_value_get_boxed (value)
+	     ? g_value_dup_boxed (value)
+	     : &PL_sv_undef;
+}
+
+static void
+enum_from_sv (const GPerlValueConverter * converter,
+	      GValue * value,
+	      SV * sv)
+{
+	g_value_set_enum (value, gperl_convert_enum (converter->gtype, sv));
+}
+
+static SV *
+enum_to_sv (const GPerlValueConverter * converter,
+	    const GValue * value,
+	    gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (copy_boxed);
+	return gperl_convert_back_enum (converter->gtype,
+					g_value_get_enum (value));
+}
+
+static void
+flags_from_sv (const GPerlValueConverter * converter,
+	       GValue * value,
+	       SV * sv)
+{
+	g_value_set_flags (value, gperl_convert_flags (converter->gtype, sv));
+}
+
+static SV *
+flags_to_sv (const GPerlValueConverter * converter,
+	     const GValue * value,
+	     gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (copy_boxed);
+	return gperl_convert_back_flags (converter->gtype,
+					 g_value_get_flags (value));
+}
+
+static void
+wrapper_from_sv (const GPerlValueConverter * converter,
+		 GValue * value,
+		 SV * sv)
+{
+	converter->wrapper_class->unwrap (value, sv);
+}
+
+static SV *
+wrapper_to_sv (const GPerlValueConverter * converter,
+	       const GValue * value,
+	       gboolean copy_boxed)
+{
+	PERL_UNUSED_VAR (copy_boxed);
+	return converter->wrapper_class->wrap (value);
+}
+
+static const GPerlValueConverter generic_converter = {
+	G_TYPE_INVALID, generic_from_sv, generic_to_sv, NULL
+};
+
+G_LOCK_DEFINE_STATIC (value_converters);
+
+const GPerlValueConverter *
+_gperl_value_converter_lookup (GType gtype)
+{
+	static GQuark quark_converter = 0;
+	GPerlValueConverter * converter;
+	GType fundamental;
+
+	if (!quark_converter)
+		quark_converter = g_quark_from_static_string
+					("GPerlValueConverter");
+
+	converter = g_type_get_qdata (gtype, quark_converter);
+	if (converter)
+		return converter;
+
+	converter = g_new0 (GPerlValueConverter, 1);
+	converter->gtype = gtype;
+	converter->from_sv = generic_from_sv;
+	converter->to_sv = generic_to_sv;
+
+	fundamental = G_TYPE_FUNDAMENTAL (gtype);
+	switch (fundamental) {
+	    case G_TYPE_INTERFACE:
+		converter->from_sv = interface_from_sv;
+		converter->to_sv = object_to_sv;
+		break;
+	    case G_TYPE_OBJECT:
+		converter->from_sv = object_from_sv;
+		converter->to_sv = object_to_sv;
+		break;
+	    case G_TYPE_BOXED:
+		if (g_type_is_a (gtype, GPERL_TYPE_SV)) {
+			converter->from_sv = perl_sv_from_sv;
+			converter->to_sv = perl_sv_to_sv;
+		} else {
+			converter->from_sv = boxed_from_sv;
+			converter->to_sv = boxed_to_sv;
+		}
+		break;
+	    case G_TYPE_ENUM:
+		converter->from_sv = enum_from_sv;
+		converter->to_sv = enum_to_sv;
+		break;
+	    case G_TYPE_FLAGS:
+		converter->from_sv = flags_from_sv;
+		converter->to_sv = flags_to_sv;
+		break;
+	    case G_TYPE_CHAR:
+	    case G_TYPE_UCHAR:
+	    case G_TYPE_BOOLEAN:
+	    case G_TYPE_INT:
+	    case G_TYPE_UINT:
+	    case G_TYPE_LONG:
+	    case G_TYPE_ULONG:
+	    case G_TYPE_INT64:
+	    case G_TYPE_UINT64:
+	    case G_TYPE_FLOAT:
+	    case G_TYPE_DOUBLE:
+	    case G_TYPE_STRING:
+	    case G_TYPE_POINTER:
+	    case G_TYPE_PARAM:
+		break;
+	    default:
+		converter->wrapper_class =
+			gperl_fundamental_wrapper_class_from_type (fundamental);
+		if (!converter->wrapper_class) {
+			/* nothing registered yet; don't remember that, so
+			 * that a later registration is picked up. */
+			g_free (converter);
+			return &generic_converter;
+		}
+		if (converter->wrapper_class->unwrap)
+			converter->from_sv = wrapper_from_sv;
+		if (converter->wrapper_class->wrap)
+			converter->to_sv = wrapper_to_sv;
+		break;
+	}
+
+	/* somebody else may have beaten us to it; keep theirs. */
+	G_LOCK (value_converters);
+	if (g_type_get_qdata (gtype, quark_converter)) {
+		g_free (converter);
+		converter = g_type_get_qdata (gtype, quark_converter);
+	} else {
+		g_type_set_qdata (gtype, quark_converter, converter);
+	}
+	G_UNLOCK (value_converters);
+
+	return converter;
+}
+
 =back
 
 =cut
@@ -215,6 +215,504 @@ sv_to_variant_type_array (SV * sv, const GVariantType *** array_p, gint * n_p)
 	}
 }
 
+
+/* --- format string driven conversion --- */
+
+/* These implement the convenience API, Glib::Variant::new and get.  They walk
+ * the GVariantType and the perl structure in parallel, building containers
+ * with GVariantBuilder and reading them with GVariantIter, so that no
+ * intermediate Glib::Variant or Glib::VariantType wrappers are created.
+ *
+ * sv_to_variant_of_type reports values it can't convert by returning NULL and
+ * storing a newly allocated message in *error.  It may still croak, e.g. in
+ * SvGChar, so each container's GVariantBuilder is cleared from the savestack
+ * of its own ENTER/LEAVE pair; nothing is left behind on success, and a croak
+ * releases everything built so far. */
+
+static GVariant * sv_to_variant_of_type (SV * sv, const GVariantType * type, gchar ** error);
+
+static void
+variant_builder_release (pTHX_ void * builder)
+{
+	PERL_UNUSED_CONTEXT;
+	/* a no-op after g_variant_builder_end */
+	g_variant_builder_clear (builder);
+}
+
+static void
+variant_type_release (pTHX_ void * type)
+{
+	PERL_UNUSED_CONTEXT;
+	g_variant_type_free (type);
+}
+
+/* initialize a builder that is cleared at the next LEAVE. */
+static void
+variant_builder_init (GVariantBuilder * builder, const GVariantType * type)
+{
+	g_variant_builder_init (builder, type);
+	SAVEDESTRUCTOR_X (variant_builder_release, builder);
+}
+
+static const gchar *
+variant_string_from_sv (SV * sv)
+{
+	return gperl_sv_is_defined (sv) ? SvGChar (sv) : "";
+}
+
+static GVariant *
+sv_to_basic_variant (SV * sv, const GVariantType * type, gchar ** error)
+{
+	const gchar * string;
+
+	switch (g_variant_type_peek_string (type)[0]) {
+	    case 'b': return g_variant_new_boolean (SvTRUE (sv));
+	    case 'y': return g_variant_new_byte ((guchar) SvUV (sv));
+	    case 'n': return g_variant_new_int16 ((gint16) SvIV (sv));
+	    case 'q': return g_variant_new_uint16 ((guint16) SvUV (sv));
+	    case 'i': return g_variant_new_int32 ((gint32) SvIV (sv));
+	    case 'u': return g_variant_new_uint32 ((guint32) SvUV (sv));
+	    case 'x': return g_variant_new_int64 (SvGInt64 (sv));
+	    case 't': return g_variant_new_uint64 (SvGUInt64 (sv));
+	    case 'h': return g_variant_new_handle ((gint32) SvIV (sv));
+	    case 'd': return g_variant_new_double (SvNV (sv));
+	    case 's':
+		return g_variant_new_string (variant_string_from_sv (sv));
+	    case 'o':
+		string = variant_string_from_sv (sv);
+		if (!g_variant_is_object_path (string)) {
+			*error = g_strdup_printf (
+				"'%s' is not a valid object path", string);
+			return NULL;
+		}
+		return g_variant_new_object_path (string);
+	    case 'g':
+		string = variant_string_from_sv (sv);
+		if (!g_variant_is_signature (string)) {
+			*error = g_strdup_printf (
+				"'%s' is not a valid signature", string);
+			return NULL;
+		}
+		return g_variant_new_signature (string);
+	}
+
+	*error = g_strdup_printf ("Cannot handle the type '%.*s'",
+	                          (int) g_variant_type_get_string_length (type),
+	                          g_variant_type_peek_string (type));
+	return NULL;
+}
+
+static GVariant *
+sv_to_dict_entry_variant (SV * key_sv,
+                          SV * value_sv,
+                          const GVariantType * type,
+                          gchar ** error)
+{
+	GVariantBuilder builder;
+	GVariant * child, * result = NULL;
+
+	ENTER;
+	variant_builder_init (&builder, type);
+	child = sv_to_variant_of_type (key_sv, g_variant_type_key (type), error);
+	if (child) {
+		g_variant_builder_add_value (&builder, child);
+		child = sv_to_variant_of_type (
+			value_sv, g_variant_type_value (type), error);
+	}
+	if (child) {
+		g_variant_builder_add_value (&builder, child);
+		result = g_variant_builder_end (&builder);
+	}
+	LEAVE;
+
+	return result;
+}
+
+static GVariant *
+sv_to_array_variant (SV * sv, const GVariantType * type, gchar ** error)
+{
+	const GVariantType * element = g_variant_type_element (type);
+	GVariantBuilder builder;
+	GVariant * result = NULL;
+
+	ENTER;
+	variant_builder_init (&builder, type);
+
+	/* undef is treated like an empty array */
+	if (gperl_sv_is_array_ref (sv)) {
+		AV * av = (AV *) SvRV (sv);
+		int i, n = av_len (av) + 1;
+		for (i = 0; i < n; i++) {
+			SV ** svp = av_fetch (av, i, 0);
+			GVariant * child = sv_to_variant_of_type (
+				svp ? *svp : &PL_sv_undef, element, error);
+			if (!child)
+				goto out;
+			g_variant_builder_add_value (&builder, child);
+		}
+	} else if (g_variant_type_is_dict_entry (element) &&
+	           gperl_sv_is_hash_ref (sv)) {
+		HV * hv = (HV *) SvRV (sv);
+		HE * he;
+		hv_iterinit (hv);
+		while ((he = hv_iternext (hv))) {
+			GVariant * child = sv_to_dict_entry_variant (
+				hv_iterkeysv (he), hv_iterval (hv, he),
+				element, error);
+			if (!child)
+				goto out;
+			g_variant_builder_add_value (&builder, child);
+		}
+	} else if (gperl_sv_is_defined (sv)) {
+		*error = g_strdup ("Expected an array ref");
+		goto out;
+	}
+
+	result = g_variant_builder_end (&builder);
+	out:
+	LEAVE;
+
+	return result;
+}
+
+static GVariant *
+sv_to_tuple_variant (SV * sv, const GVariantType * type, gchar ** error)
+{
+	const GVariantType * item;
+	GVariantBuilder builder;
+	GVariant * result = NULL;
+	gsize i, n = g_variant_type_n_items (type);
+	AV * av = NULL;
+
+	if (n) {
+		if (!gperl_sv_is_array_ref (sv) ||
+		    (gsize) (av_len ((AV *) SvRV (sv)) + 1) != n) {
+			*error = g_strdup_printf (
+				"Expected an array ref with %d elements", (int) n);
+			return NULL;
+		}
+		av = (AV *) SvRV (sv);
+	}
+
+	ENTER;
+	variant_builder_init (&builder, type);
+	for (i = 0, item = g_variant_type_first (type);
+	     item;
+	     i++, item = g_variant_type_next (item))
+	{
+		SV ** svp = av_fetch (av, i, 0);
+		GVariant * child = sv_to_variant_of_type (
+			svp ? *svp : &PL_sv_undef, item, error);
+		if (!child)
+			goto out;
+		g_variant_builder_add_value (&builder, child);
+	}
+
+	result = g_variant_builder_end (&builder);
+	out:
+	LEAVE;
+
+	return result;
+}
+
+static GVariant *
+sv_to_variant_of_type (SV * sv, const GVariantType * type, gchar ** error)
+{
+	if (g_variant_type_is_basic (type))
+		return sv_to_basic_variant (sv, type, error);
+
+	if (g_variant_type_is_variant (type)) {
+		GVariant * child = SvGVariant (sv);
+		if (!child) {
+			*error = g_strdup ("Expected a Glib::Variant");
+			return NULL;
+		}
+		return g_variant_new_variant (child);
+	}
+
+	if (g_variant_type_is_maybe (type)) {
+		GVariant * child = NULL;
+		if (gperl_sv_is_defined (sv)) {
+			child = sv_to_variant_of_type (
+				sv, g_variant_type_element (type), error);
+			if (!child)
+				return NULL;
+		}
+		return g_variant_new_maybe (g_variant_type_element (type), child);
+	}
+
+	if (g_variant_type_is_array (type))
+		return sv_to_array_variant (sv, type, error);
+
+	if (g_variant_type_is_tuple (type))
+		return sv_to_tuple_variant (sv, type, error);
+
+	if (g_variant_type_is_dict_entry (type)) {
+		AV * av;
+		SV ** key_svp, ** value_svp;
+		if (!gperl_sv_is_array_ref (sv)) {
+			*error = g_strdup ("Expected an array ref with 2 elements");
+			return NULL;
+		}
+		av = (AV *) SvRV (sv);
+		key_svp = av_fetch (av, 0, 0);
+		value_svp = av_fetch (av, 1, 0);
+		return sv_to_dict_entry_variant (
+			key_svp ? *key_svp : &PL_sv_undef,
+			value_svp ? *value_svp : &PL_sv_undef,
+			type, error);
+	}
+
+	*error = g_strdup_printf ("Cannot handle the type '%.*s'",
+	                          (int) g_variant_type_get_string_length (type),
+	                          g_variant_type_peek_string (type));
+	return NULL;
+}
+
+static SV *
+variant_to_sv_of_type (GVariant * variant, const GVariantType * type)
+{
+	if (g_variant_type_is_basic (type)) {
+		switch (g_variant_type_peek_string (type)[0]) {
+		    case 'b': return newSVsv (boolSV (g_variant_get_boolean (variant)));
+		    case 'y': return newSVuv (g_variant_get_byte (variant));
+		    case 'n': return newSViv (g_variant_get_int16 (variant));
+		    case 'q': return newSVuv (g_variant_get_uint16 (variant));
+		    case 'i': return newSViv (g_variant_get_int32 (variant));
+		    case 'u': return newSVuv (g_variant_get_uint32 (variant));
+		    case 'x': return newSVGInt64 (g_variant_get_int64 (variant));
+		    case 't': return newSVGUInt64 (g_variant_get_uint64 (variant));
+		    case 'h': return newSViv (g_variant_get_handle (variant));
+		    case 'd': return newSVnv (g_variant_get_double (variant));
+		    default: /* s, o and g */
+			return newSVGChar (g_variant_get_string (variant, NULL));
+		}
+	}
+
+	if (g_variant_type_is_variant (type))
+		return newSVGVariant_noinc (g_variant_get_variant (variant));
+
+	if (g_variant_type_is_maybe (type)) {
+		GVariant * child = g_variant_get_maybe (variant);
+		SV * sv;
+		if (!child)
+			return newSV (0);
+		sv = variant_to_sv_of_type (child, g_variant_type_element (type));
+		g_variant_unref (child);
+		return sv;
+	}
+
+	/* arrays, tuples and dictionary entries all become array refs */
+	{
+		AV * av = newAV ();
+		GVariantIter iter;
+		GVariant * child;
+		const GVariantType * child_type;
+		gsize n = g_variant_iter_init (&iter, variant);
+		gboolean is_array = g_variant_type_is_array (type);
+
+		if (n)
+			av_extend (av, n - 1);
+		child_type = is_array
+		           ? g_variant_type_element (type)
+		           : g_variant_type_first (type);
+		while ((child = g_variant_iter_next_value (&iter))) {
+			av_push (av, variant_to_sv_of_type (child, child_type));
+			g_variant_unref (child);
+			if (!is_array)
+				child_type = g_variant_type_next (child_type);
+		}
+		return newRV_noinc ((SV *) av);
+	}
+}
+
+/* --- lazy views --- */
+
+/* Glib::Variant::view returns tied array and hash references over container
+ * variants.  The tie object wraps a VariantView, and children are converted
+ * only when they are fetched; nested containers become views themselves.
+ *
+ * Dictionaries with string-like keys are presented as hashes.  The first key
+ * lookup builds an index from key to child position, which only reads the
+ * keys, so later lookups don't have to scan the dictionary again. */
+
+typedef struct {
+	GVariant * variant;
+	GHashTable * index;
+	gsize next_key;
+} VariantView;
+
+static SV *
+variant_view_new (GVariant * variant, const char * package)
+{
+	VariantView * view = g_new0 (VariantView, 1);
+	view->variant = g_variant_ref (variant);
+	return sv_setref_pv (newSV (0), package, view);
+}
+
+static VariantView *
+SvVariantView (SV * sv, const char * package)
+{
+	if (!gperl_sv_is_ref (sv) || !sv_derived_from (sv, package))
+		croak ("%s is not of type %s",
+		       gperl_format_variable_for_output (sv), package);
+	return INT2PTR (VariantView *, SvIV (SvRV (sv)));
+}
+
+static void
+variant_view_free (VariantView * view)
+{
+	if (view->index)
+		g_hash_table_destroy (view->index);
+	g_variant_unref (view->variant);
+	g_free (view);
+}
+
+static gboolean
+variant_type_is_string_dict (const GVariantType * type)
+{
+	const GVariantType * element;
+	if (!g_variant_type_is_array (type))
+		return FALSE;
+	element = g_variant_type_element (type);
+	if (!g_variant_type_is_dict_entry (element))
+		return FALSE;
+	switch (g_variant_type_peek_string (g_variant_type_key (element))[0]) {
+	    case 's': case 'o': case 'g':
+		return TRUE;
+	}
+	return FALSE;
+}
+
+static SV *
+variant_to_view (GVariant * variant)
+{
+	const GVariantType * type = g_variant_get_type (variant);
+	SV * tie, * container;
+
+	if (g_variant_type_is_maybe (type)) {
+		GVariant * child = g_variant_get_maybe (variant);
+		SV * sv;
+		if (!child)
+			return newSV (0);
+		sv = variant_to_view (child);
+		g_variant_unref (child);
+		return sv;
+	}
+
+	if (!g_variant_type_is_array (type) &&
+	    !g_variant_type_is_tuple (type) &&
+	    !g_variant_type_is_dict_entry (type))
+		return variant_to_sv_of_type (variant, type);
+
+	if (variant_type_is_string_dict (type)) {
+		tie = variant_view_new (variant, "Glib::Variant::HashView");
+		container = (SV *) newHV ();
+	} else {
+		tie = variant_view_new (variant, "Glib::Variant::ArrayView");
+		container = (SV *) newAV ();
+	}
+	sv_magic (container, tie, PERL_MAGIC_tied, NULL, 0);
+	SvREFCNT_dec (tie);
+
+	return newRV_noinc (container);
+}
+
+static void
+variant_view_build_index (VariantView * view)
+{
+	gsize i, n = g_variant_n_children (view->variant);
+
+	view->index = g_hash_table_new_full (g_str_hash, g_str_equal,
+	                                     g_free, NULL);
+	for (i = 0; i < n; i++) {
+		GVariant * entry = g_variant_get_child_value (view->variant, i);
+		GVariant * key = g_variant_get_child_value (entry, 0);
+		const gchar * string = g_variant_get_string (key, NULL);
+		/* like g_variant_lookup_value, the first entry wins */
+		if (!g_hash_table_lookup (view->index, string))
+			g_hash_table_insert (view->index, g_strdup (string),
+			                     GSIZE_TO_POINTER (i + 1));
+		g_variant_unref (key);
+		g_variant_unref (entry);
+	}
+}
+
+/* returns the child position of key plus one, or 0 if it is not there. */
+static gsize
+variant_view_lookup (VariantView * view, const gchar * key)
+{
+	if (!view->index)
+		variant_view_build_index (view);
+	return GPOINTER_TO_SIZE (g_hash_table_lookup (view->index, key));
+}
+
+/* returns the next key for iteration, or NULL at the end.  dictionaries may
+ * contain a key more than once; since FETCH and EXISTS only see the first
+ * entry, so does iteration. */
+static SV *
+variant_view_next_key (VariantView * view)
+{
+	gsize n = g_variant_n_children (view->variant);
+	SV * sv = NULL;
+
+	if (!view->index)
+		variant_view_build_index (view);
+	while (!sv && view->next_key < n) {
+		gsize i = view->next_key++;
+		GVariant * entry = g_variant_get_child_value (view->variant, i);
+		GVariant * key = g_variant_get_child_value (entry, 0);
+		const gchar * string = g_variant_get_string (key, NULL);
+		if (variant_view_lookup (view, string) == i + 1)
+			sv = newSVGChar (string);
+		g_variant_unref (key);
+		g_variant_unref (entry);
+	}
+	return sv;
+}
+
+static SV *
+variant_view_entry_part (VariantView * view, gsize i, gsize part)
+{
+	GVariant * entry = g_variant_get_child_value (view->variant, i);
+	GVariant * child = g_variant_get_child_value (entry, part);
+	SV * sv = part == 0
+	        ? newSVGChar (g_variant_get_string (child, NULL))
+	        : variant_to_view (child);
+	g_variant_unref (child);
+	g_variant_unref (entry);
+	return sv;
+}
+
+/* parses the first complete type at the start of *format and advances
+ * *format past it.  croaks if it is not a definite type. */
+static GVariantType *
+variant_type_scan_definite (const gchar ** format)
+{
+	const gchar * start = *format;
+	const gchar * end;
+	gchar * type_string;
+	GVariantType * type;
+
+	if (!g_variant_type_string_scan (start, NULL, &end))
+		croak ("Could not find type string at the start of '%s'", start);
+
+	type_string = g_strndup (start, end - start);
+	if (!g_variant_type_string_is_valid (type_string) ||
+	    !g_variant_type_is_definite ((const GVariantType *) type_string))
+	{
+		SV * part = sv_2mortal (newSVpv (type_string, 0));
+		g_free (type_string);
+		croak ("Cannot handle the part '%s' in the format string '%s'",
+		       SvPV_nolen (part), start);
+	}
+	type = g_variant_type_new (type_string);
+	g_free (type_string);
+
+	*format = end;
+	return type;
+}
+
 /* -------------------------------------------------------------------------- */
 
 MODULE = Glib::Variant	PACKAGE = Glib::Variant	PREFIX = g_variant_
@@ -308,6 +806,86 @@ BOOT:
 	gperl_register_boxed (G_TYPE_VARIANT_DICT, "Glib::VariantDict", NULL);
 #endif
 
+=for apidoc __hide__
+=cut
+void
+new (class, const gchar_ornull * format=NULL, ...)
+    PREINIT:
+	int value_index = 2;
+    PPCODE:
+	while (format && *format) {
+		GVariantType * type;
+		GVariant * variant;
+		gchar * error = NULL;
+
+		type = variant_type_scan_definite (&format);
+		ENTER;
+		SAVEDESTRUCTOR_X (variant_type_release, type);
+		variant = sv_to_variant_of_type (
+			value_index < items ? ST (value_index) : &PL_sv_undef,
+			type, &error);
+		LEAVE;
+		if (!variant) {
+			SV * message = sv_2mortal (newSVpv (error, 0));
+			g_free (error);
+			croak ("%s", SvPV_nolen (message));
+		}
+		XPUSHs (sv_2mortal (newSVGVariant_noinc (variant)));
+		value_index++;
+
+		/* in scalar context, only the first variant is wanted */
+		if (GIMME_V != G_ARRAY)
+			break;
+	}
+
+=for apidoc __hide__
+=cut
+void
+get (GVariant * variant, const gchar_ornull * format=NULL)
+    PREINIT:
+	const gchar * start;
+	GVariantType * type;
+	SV * sv;
+    PPCODE:
+	if (!format || !*format)
+		XSRETURN_EMPTY;
+	start = format;
+	if (!variant)
+		croak ("Expected a Glib::Variant");
+	type = variant_type_scan_definite (&format);
+	if (*format)
+		warn ("Unhandled rest of format string detected: '%s'", format);
+	if (!g_variant_is_of_type (variant, type)) {
+		g_variant_type_free (type);
+		croak ("Cannot read a variant of type '%s' with the format '%s'",
+		       g_variant_get_type_string (variant), start);
+	}
+	sv = variant_to_sv_of_type (variant, type);
+	g_variant_type_free (type);
+	XPUSHs (sv_2mortal (sv));
+
+=for apidoc
+Returns a lazy, read-only view of I<$variant>.  Arrays, tuples and dictionary
+entries become references to tied arrays; arrays of dictionary entries whose
+keys are strings, object paths or signatures become references to tied hashes.
+Children are only converted when they are accessed, and containers among them
+become views themselves.  Maybe types yield the view of their content or undef,
+and all other types are converted as by C<get>.
+
+Looking up a key in a hash view builds an index of the keys on first use, so
+reading a few entries out of a large dictionary does not convert the rest of
+it.  If a dictionary contains a key more than once, the hash view only has
+the first entry for it, for lookups as well as for C<keys> and C<each>.
+=cut
+SV *
+view (GVariant * variant)
+    CODE:
+	if (!variant)
+		croak ("Expected a Glib::Variant");
+	RETVAL = variant_to_view (variant);
+    OUTPUT:
+	RETVAL
+
 const GVariantType * g_variant_get_type (GVariant *value);
 
 const gchar * g_variant_get_type_string (GVariant *value);
@@ -405,9 +983,42 @@ GVariant_noinc * g_variant_new_bytestring (class, const char_byte * string);
 # GLIB_AVAILABLE_IN_2_32
 # GVariant * g_variant_new_fixed_array (const GVariantType *element_type, gconstpointer elements, gsize n_elements, gsize element_size);
 
-# FIXME:
-# GLIB_AVAILABLE_IN_2_36
-# GVariant * g_variant_new_from_bytes (const GVariantType *type, GBytes *bytes, gboolean trusted);
+#if GLIB_CHECK_VERSION (2, 36, 0)
+
+=for apidoc
+Creates a variant of type I<$type> whose serialized data is the contents of
+I<$bytes>.  The data is not copied; the variant keeps a reference on
+I<$bytes>.  Unless I<$trusted> is true, the data is checked lazily as parts of
+it are accessed, so untrusted input is safe to use.
+=cut
+GVariant_noinc * g_variant_new_from_bytes (class, const GVariantType *type, GBytes *bytes, gboolean trusted=FALSE);
+    C_ARGS:
+	type, bytes, trusted
+
+=for apidoc __gerror__
+Maps I<$filename> read-only and creates a variant of type I<$type> over the
+mapping, without reading the file into memory.  The mapping stays alive as long
+as the variant or any value taken from it.  See C<new_from_bytes> for the
+meaning of I<$trusted>.
+=cut
+GVariant_noinc *
+new_from_file (class, const GVariantType *type, GPerlFilename filename, gboolean trusted=FALSE)
+    PREINIT:
+	GMappedFile *file;
+	GBytes *bytes;
+	GError *error = NULL;
+    CODE:
+	file = g_mapped_file_new (filename, FALSE, &error);
+	if (!file)
+		gperl_croak_gerror (NULL, error);
+	bytes = g_mapped_file_get_bytes (file);
+	g_mapped_file_unref (file);
+	RETVAL = g_variant_new_from_bytes (type, bytes, trusted);
+	g_bytes_unref (bytes);
+    OUTPUT:
+	RETVAL
+
+#endif
 
 # FIXME:
 # GVariant * g_variant_new_from_data (const GVariantType *type, gconstpointer data, gsize size, gboolean trusted, GDestroyNotify notify, gpointer user_data);
@@ -509,10 +1120,18 @@ GVariant_noinc * g_variant_lookup_value (GVariant *dictionary, const gchar *key,
 
 gsize g_variant_get_size (GVariant *value);
 
+#if GLIB_CHECK_VERSION (2, 36, 0)
+
+=for apidoc
+Returns the serialized form of I<$value> as a L<Glib::Bytes>.  This does not
+copy the data unless the variant has not been serialized yet.
+=cut
+GBytes_own * g_variant_get_data_as_bytes (GVariant *value);
+
+#endif
+
 # FIXME:
 # gconstpointer g_variant_get_data (GVariant *value);
-# GLIB_AVAILABLE_IN_2_36
-# GBytes * g_variant_get_data_as_bytes (GVariant *value);
 # void g_variant_store (GVariant *value, gpointer data);
 
 # GString * g_variant_print_string (GVariant *value, GString *string, gboolean type_annotate);
@@ -534,13 +1153,6 @@ gboolean g_variant_is_normal_form (GVariant *value);
 
 GVariant_noinc * g_variant_byteswap (GVariant *value);
 
-# FIXME:
-# GLIB_AVAILABLE_IN_2_36
-# GVariant * g_variant_new_from_bytes (const GVariantType *type, GBytes *bytes, gboolean trusted);
-
-# FIXME:
-# GVariant * g_variant_new_from_data (const GVariantType *type, gconstpointer data, gsize size, gboolean trusted, GDestroyNotify notify, gpointer user_data);
-
 void
 DESTROY (GVariant * variant)
     CODE:
@@ -603,6 +1215,163 @@ g_variant_parse (const GVariantType *type, const gchar *text)
 
 # --------------------------------------------------------------------------- #
 
+MODULE = Glib::Variant	PACKAGE = Glib::Variant::ArrayView
+
+=for apidoc __hide__
+=cut
+gsize
+FETCHSIZE (SV * view)
+    CODE:
+	RETVAL = g_variant_n_children (
+		SvVariantView (view, "Glib::Variant::ArrayView")->variant);
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+SV *
+FETCH (SV * view, IV position)
+    PREINIT:
+	VariantView * v;
+	GVariant * child;
+    CODE:
+	v = SvVariantView (view, "Glib::Variant::ArrayView");
+	if (position < 0 || (gsize) position >= g_variant_n_children (v->variant))
+		XSRETURN_UNDEF;
+	child = g_variant_get_child_value (v->variant, position);
+	RETVAL = variant_to_view (child);
+	g_variant_unref (child);
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+gboolean
+EXISTS (SV * view, IV position)
+    CODE:
+	RETVAL = position >= 0 &&
+		(gsize) position < g_variant_n_children (
+			SvVariantView (view, "Glib::Variant::ArrayView")->variant);
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+void
+EXTEND (SV * view, ...)
+    CODE:
+	PERL_UNUSED_VAR (view);
+
+=for apidoc __hide__
+=cut
+void
+STORE (SV * view, ...)
+    ALIAS:
+	STORESIZE = 1
+	DELETE = 2
+	CLEAR = 3
+	PUSH = 4
+	POP = 5
+	SHIFT = 6
+	UNSHIFT = 7
+	SPLICE = 8
+    CODE:
+	PERL_UNUSED_VAR (view);
+	PERL_UNUSED_VAR (ix);
+	croak ("Glib::Variant views are read-only");
+
+=for apidoc __hide__
+=cut
+void
+DESTROY (SV * view)
+    CODE:
+	variant_view_free (SvVariantView (view, "Glib::Variant::ArrayView"));
+
+# --------------------------------------------------------------------------- #
+
+MODULE = Glib::Variant	PACKAGE = Glib::Variant::HashView
+
+=for apidoc __hide__
+=cut
+SV *
+FETCH (SV * view, const gchar * key)
+    PREINIT:
+	VariantView * v;
+	gsize position;
+    CODE:
+	v = SvVariantView (view, "Glib::Variant::HashView");
+	position = variant_view_lookup (v, key);
+	if (!position)
+		XSRETURN_UNDEF;
+	RETVAL = variant_view_entry_part (v, position - 1, 1);
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+gboolean
+EXISTS (SV * view, const gchar * key)
+    CODE:
+	RETVAL = variant_view_lookup (
+		SvVariantView (view, "Glib::Variant::HashView"), key) != 0;
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+SV *
+FIRSTKEY (SV * view, ...)
+    ALIAS:
+	NEXTKEY = 1
+    PREINIT:
+	VariantView * v;
+    CODE:
+	/* NEXTKEY also gets the previous key, which we don't need. */
+	v = SvVariantView (view, "Glib::Variant::HashView");
+	if (ix == 0)
+		v->next_key = 0;
+	RETVAL = variant_view_next_key (v);
+	if (!RETVAL)
+		XSRETURN_UNDEF;
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+gsize
+SCALAR (SV * view)
+    PREINIT:
+	VariantView * v;
+    CODE:
+	/* the number of distinct keys, as seen by iteration */
+	v = SvVariantView (view, "Glib::Variant::HashView");
+	if (!v->index)
+		variant_view_build_index (v);
+	RETVAL = g_hash_table_size (v->index);
+    OUTPUT:
+	RETVAL
+
+=for apidoc __hide__
+=cut
+void
+STORE (SV * view, ...)
+    ALIAS:
+	DELETE = 1
+	CLEAR = 2
+    CODE:
+	PERL_UNUSED_VAR (view);
+	PERL_UNUSED_VAR (ix);
+	croak ("Glib::Variant views are read-only");
+
+=for apidoc __hide__
+=cut
+void
+DESTROY (SV * view)
+    CODE:
+	variant_view_free (SvVariantView (view, "Glib::Variant::HashView"));
+
+# --------------------------------------------------------------------------- #
+
 MODULE = Glib::Variant	PACKAGE = Glib::VariantType	PREFIX = g_variant_type_
 
 =for object Glib::VariantType Utilities for dealing with the GVariant type system
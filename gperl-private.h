@@ -47,6 +47,35 @@ SV * _gperl_sv_from_value_internal (const GValue * value, gboolean copy_boxed);
 
 SV * _gperl_fetch_wrapper_key (GObject * object, const char * name, gboolean create);
 
+/*
+ * GValue <-> SV converters resolved for one concrete GType.  Look one up
+ * once, e.g. per signal signature or per property, and then convert any
+ * number of values of that type without going through the generic
+ * dispatch again.
+ */
+typedef struct _GPerlValueConverter GPerlValueConverter;
+typedef void (*GPerlConverterFromSVFunc) (const GPerlValueConverter * converter,
+                                          GValue * value,
+                                          SV * sv);
+typedef SV * (*GPerlConverterToSVFunc) (const GPerlValueConverter * converter,
+                                        const GValue * value,
+                                        gboolean copy_boxed);
+struct _GPerlValueConverter {
+	GType                    gtype;
+	GPerlConverterFromSVFunc from_sv;
+	GPerlConverterToSVFunc   to_sv;
+	GPerlValueWrapperClass * wrapper_class;
+};
+const GPerlValueConverter * _gperl_value_converter_lookup (GType gtype);
+
+/* like gperl_value_from_sv, undef leaves the value's default alone. */
+#define _gperl_converter_value_from_sv(converter, value, sv)		\
+	(gperl_sv_is_defined (sv)					\
+	 ? (converter)->from_sv ((converter), (value), (sv))		\
+	 : (void) 0)
+#define _gperl_converter_sv_from_value(converter, value, copy_boxed)	\
+	((converter)->to_sv ((converter), (value), (copy_boxed)))
+
 #define SAVED_STACK_SV(expr)			\
 	({					\
 		SV *_saved_stack_sv;		\
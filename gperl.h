@@ -243,6 +243,7 @@ struct _GPerlClosure {
 	SV * data; /* callback data */
 	gboolean swap; /* TRUE if target and data are to be swapped */
 	int id;
+	guint signal_id; /* set by gperl_signal_connect; 0 if not connected */
 };
 
 /* evaluates to true if the instance and data are to be swapped on invocation */
@@ -257,6 +258,8 @@ GClosure * gperl_closure_new_with_marshaller (SV              * callback,
                                               SV              * data, 
                                               gboolean          swap,
                                               GClosureMarshal   marshaller);
+/* don't block foreign threads invoking closures that return nothing */
+void gperl_closure_set_async_foreign_dispatch (gboolean async);
 
 /*
  * --- GPerlCallback ----------------------------------------------------------
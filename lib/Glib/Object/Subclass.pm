@@ -258,6 +258,11 @@ properties at creation time.  The default values in your properties are also
 honored if you don't set anything else.  See Glib::Type::register_object in
 L<Glib::Type> for an example.
 
+Properties without a getter or setter are stored in the object's hash by
+default.  Classes with many objects or heavily used properties may pass
+C<< property_storage => 'slots' >> to store them in a compact array
+instead; see Glib::Type::register_object in L<Glib::Type>.
+
 =head1 SIGNALS
 
 Creating new signals for your new object is easy.  Just provide a hash
@@ -319,6 +324,51 @@ The two return values are a boolean C<$cont> for whether signal emission
 should continue (false to stop); and a new C<$acc> accumulated return value.
 (This is different from the C version, which writes through a return_accu.)
 
+Some accumulators are needed so often that they are built in; give one of
+the Glib::Signal::ACCUMULATE_* constants instead of a function to have them
+run in C, without calling into perl for every handler.  (A plain string is
+always taken as the name of a perl sub, even if it matches one of these.)
+
+=over
+
+=item Glib::Signal::ACCUMULATE_FIRST_WINS
+
+The first handler to run determines the return value; no further handlers
+are run.
+
+=item Glib::Signal::ACCUMULATE_TRUE_HANDLED
+
+For Glib::Boolean signals.  Emission stops at the first handler that
+returns true, which then is the return value.
+
+=item Glib::Signal::ACCUMULATE_LOGICAL_OR
+
+For Glib::Boolean signals.  All handlers run, and the return value is true
+if any of them returned true.
+
+=item Glib::Signal::ACCUMULATE_SUM
+
+For numeric signals.  The return value is the sum of all handlers' return
+values.
+
+=item Glib::Signal::ACCUMULATE_COLLECT
+
+For Glib::Scalar signals.  The return value is a reference to an array
+holding the return values of all handlers, in the order they ran; a handler
+that returned undef contributes an undef.
+
+=back
+
+For example:
+
+  signals => {
+    delete_request => {
+      return_type => 'Glib::Boolean',
+      flags       => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_TRUE_HANDLED,
+    },
+  },
+
 =back
 
 =head1 OVERRIDING BASE METHODS
@@ -12,7 +12,7 @@ use Test::More;
 unless (Glib -> CHECK_VERSION (2, 32, 0)) {
   plan skip_all => 'GBytes is new in 2.32';
 } else {
-  plan tests => 13;
+  plan tests => 22;
 }
 
 # Basic API.
@@ -48,3 +48,27 @@ eval {
   is ($bytes->get_data, pack ('C*', 0xE2,0x99,0xA5));
 };
 is ($@, '');
+
+# Zero-copy bridging.
+{
+  my $borrowed = Glib::Bytes->new_borrowed ($data);
+  is ($borrowed->get_data, $data);
+  $data .= 'more';
+  is ($borrowed->get_size, 256, 'later changes do not show through');
+
+  use constant CONSTANT_DATA => 'constant';
+  my $const = Glib::Bytes->new_borrowed (CONSTANT_DATA);
+  is ($const->get_data, 'constant');
+
+  my $number = Glib::Bytes->new_borrowed (23);
+  is ($number->get_data, '23');
+
+  eval { Glib::Bytes->new_borrowed ("\x{2665}") };
+  like ($@, qr/Wide character/);
+
+  my $view_of = sub { is ($_[0], 'constant'); ok (Internals::SvREADONLY ($_[0])) };
+  $view_of->($const->get_data_borrowed);
+
+  is (length $const->get_data_borrowed, 8);
+  is (Glib::Bytes->new ('')->get_data_borrowed, '');
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/perl
+
+#
+# Test handing invocations from threads without a perl interpreter over to
+# the main loop, both blocking and queued.
+#
+
+use strict;
+use warnings;
+use Glib qw(TRUE FALSE);
+use Test::More tests => 5;
+
+package Ticker;
+
+# no class closure, so that no perl code runs in the emitting thread
+use Glib::Object::Subclass
+  'Glib::Object',
+  signals => {
+    tick => {
+      param_types => ['Glib::Int'],
+      class_closure => undef,
+    },
+  };
+
+package main;
+
+my $loop = Glib::MainLoop->new;
+
+sub run_ticks {
+  my ($n) = @_;
+  my $ticker = Ticker->new;
+  my @got;
+  $ticker->signal_connect (tick => sub {
+    push @got, $_[1];
+    $loop->quit if @got == $n;
+  });
+  my $timeout = Glib::Timeout->add (10000, sub { $loop->quit; FALSE });
+  Glib->_emit_from_foreign_thread ($ticker, 'tick', $n);
+  $loop->run;
+  Glib::Source->remove ($timeout) if @got == $n;
+  return \@got;
+}
+
+# the toggle itself; with nothing queued, the main loop runs as usual
+Glib->set_async_foreign_dispatch (TRUE);
+my $ran = 0;
+Glib::Idle->add (sub { $ran++; $loop->quit; FALSE });
+$loop->run;
+is ($ran, 1, 'main loop runs with async dispatch on');
+Glib->set_async_foreign_dispatch (FALSE);
+
+SKIP: {
+  skip 'emitting from a foreign thread needs a build configured with '
+     . '--enable-test-helpers', 4
+    unless Glib->can ('_emit_from_foreign_thread');
+
+  is_deeply (run_ticks (5), [0 .. 4], 'blocking dispatch by default');
+
+  Glib->set_async_foreign_dispatch (TRUE);
+  is_deeply (run_ticks (50), [0 .. 49],
+             'queued invocations are drained in order');
+
+  Glib->set_async_foreign_dispatch (FALSE);
+  is_deeply (run_ticks (5), [0 .. 4],
+             'blocking dispatch after turning it off');
+
+  Glib->set_async_foreign_dispatch (TRUE);
+  is_deeply (run_ticks (50), [0 .. 49],
+             'queued again after turning it back on');
+  Glib->set_async_foreign_dispatch (FALSE);
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/perl
+
+#
+# Test Glib::Object::install_property_accessors.
+#
+
+use strict;
+use warnings;
+use Glib;
+use Test::More tests => 19;
+
+package MyAccessorClass;
+
+use Glib::Object::Subclass
+	Glib::Object::,
+	properties => [
+		Glib::ParamSpec->string (
+			'some-string', 'Some String', 'read/write string',
+			'default', [qw/readable writable/]),
+		Glib::ParamSpec->int (
+			'read_int', 'Read Int', 'read-only int',
+			0, 100, 23, [qw/readable/]),
+		Glib::ParamSpec->int (
+			'made_int', 'Made Int', 'construct-only int',
+			0, 100, 42, [qw/readable writable construct-only/]),
+	];
+
+sub get_made_int { 'hand-written' }
+
+package main;
+
+my @installed = sort MyAccessorClass->install_property_accessors;
+is_deeply (\@installed,
+           [qw/get_read_int get_some_string set_some_string/],
+           'accessors for own properties');
+
+ok (MyAccessorClass->can ('get_some_string'));
+ok (MyAccessorClass->can ('set_some_string'));
+ok (MyAccessorClass->can ('get_read_int'));
+ok (!MyAccessorClass->can ('set_read_int'), 'no setter for read-only');
+ok (!MyAccessorClass->can ('set_made_int'), 'no setter for construct-only');
+
+my $obj = MyAccessorClass->new (made_int => 7);
+is ($obj->get_some_string, 'default');
+$obj->set_some_string ('changed');
+is ($obj->get_some_string, 'changed');
+is ($obj->get ('some-string'), 'changed', 'setter went through GObject');
+is ($obj->get_read_int, 23);
+is ($obj->get_made_int, 'hand-written', 'existing methods are left alone');
+
+eval { $obj->get_some_string (1) };
+like ($@, qr/Usage/);
+
+eval { MyAccessorClass::get_read_int (Glib::Object->new) };
+like ($@, qr/is not of type MyAccessorClass/);
+
+# deleting an accessor frees it; installing again creates a fresh one
+delete $MyAccessorClass::{get_read_int};
+is_deeply ([MyAccessorClass->install_property_accessors ('read_int')],
+           ['get_read_int'], 'deleted accessor is installed again');
+is ($obj->get_read_int, 23);
+
+is_deeply ([Glib::Object->install_property_accessors], [],
+           'Glib::Object has no properties of its own');
+
+# explicitly named, inherited properties
+package MyAccessorChild;
+use Glib::Object::Subclass 'MyAccessorClass';
+
+package main;
+
+is_deeply ([MyAccessorChild->install_property_accessors ('read-int')],
+           ['get_read_int'], 'named inherited property');
+my $child = MyAccessorChild->new;
+is ($child->get_read_int, 23);
+
+eval { MyAccessorChild->install_property_accessors ('no-such-thing') };
+like ($@, qr/does not support property 'no-such-thing'/);
@@ -0,0 +1,70 @@
+#!/usr/bin/perl
+
+#
+# Test slot storage for properties of perl subclasses.
+#
+
+use strict;
+use warnings;
+use Glib;
+use Test::More tests => 10;
+
+package MySlotted;
+
+use Glib::Object::Subclass
+	Glib::Object::,
+	property_storage => 'slots',
+	properties => [
+		Glib::ParamSpec->string ('name', 'Name', 'a string',
+		                         'nobody', [qw/readable writable/]),
+		Glib::ParamSpec->int ('count', 'Count', 'an int',
+		                      0, 100, 7, [qw/readable writable/]),
+	];
+
+package MySlottedChild;
+
+use Glib::Object::Subclass
+	MySlotted::,
+	property_storage => 'slots',
+	properties => [
+		Glib::ParamSpec->int ('extra', 'Extra', 'another int',
+		                      0, 100, 3, [qw/readable writable/]),
+	];
+
+package MyHashedChild;
+
+use Glib::Object::Subclass
+	MySlotted::,
+	properties => [
+		Glib::ParamSpec->int ('hashed', 'Hashed', 'a hash stored int',
+		                      0, 100, 5, [qw/readable writable/]),
+	];
+
+package main;
+
+my $obj = MySlotted->new;
+is ($obj->get ('name'), 'nobody', 'default before anything was set');
+$obj->set (name => 'somebody', count => 42);
+is_deeply ([$obj->get (qw/name count/)], ['somebody', 42]);
+ok (!exists $obj->{name}, 'not stored in the hash');
+
+my $other = MySlotted->new (count => 1);
+is ($other->get ('count'), 1, 'objects have their own slots');
+is ($obj->get ('count'), 42);
+
+my $child = MySlottedChild->new (name => 'child', extra => 9);
+is_deeply ([$child->get (qw/name count extra/)], ['child', 7, 9],
+           'subclass slots come after the parent\'s');
+$child->set (count => 11);
+is_deeply ([$child->get (qw/name count extra/)], ['child', 11, 9]);
+
+my $hashed = MyHashedChild->new (hashed => 8, count => 2);
+is_deeply ([$hashed->get (qw/hashed count/)], [8, 2],
+           'subclass with hash storage');
+is ($hashed->{hashed}, 8, 'hash storage is still the default');
+
+eval {
+  Glib::Type->register_object ('Glib::Object', 'MyBadStorage',
+                               property_storage => 'elsewhere');
+};
+like ($@, qr/property_storage must be 'hash' or 'slots'/);
@@ -0,0 +1,100 @@
+#!/usr/bin/perl
+
+#
+# Test the built-in signal accumulators.
+#
+
+use strict;
+use warnings;
+use Glib qw(TRUE FALSE);
+use Test::More tests => 9;
+
+package MyAccumulating;
+
+use Glib::Object::Subclass
+  'Glib::Object',
+  signals => {
+    first => {
+      return_type => 'Glib::String',
+      flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_FIRST_WINS,
+    },
+    handled => {
+      return_type => 'Glib::Boolean',
+      flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_TRUE_HANDLED,
+    },
+    any => {
+      return_type => 'Glib::Boolean',
+      flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_LOGICAL_OR,
+    },
+    total => {
+      return_type => 'Glib::Int',
+      flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_SUM,
+    },
+    all => {
+      return_type => 'Glib::Scalar',
+      flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_COLLECT,
+    },
+    # a plain string still names a perl sub, even if it looks like one of
+    # the built-ins
+    named => {
+      return_type => 'Glib::String',
+      flags => 'run-last',
+      accumulator => 'sum',
+    },
+  };
+
+sub do_all { 'class' }
+
+package main;
+
+sub sum {
+  my ($ihint, $acc, $ret) = @_;
+  return (TRUE, (defined $acc ? $acc : '') . $ret);
+}
+
+my $obj = MyAccumulating->new;
+my @ran;
+
+$obj->signal_connect (first => sub { push @ran, 'f1'; 'one' });
+$obj->signal_connect (first => sub { push @ran, 'f2'; 'two' });
+is ($obj->signal_emit ('first'), 'one', 'first-wins');
+is_deeply (\@ran, ['f1'], 'first-wins stops the emission');
+
+@ran = ();
+$obj->signal_connect (handled => sub { push @ran, 'h1'; FALSE });
+$obj->signal_connect (handled => sub { push @ran, 'h2'; TRUE });
+$obj->signal_connect (handled => sub { push @ran, 'h3'; FALSE });
+ok ($obj->signal_emit ('handled'), 'true-handled');
+is_deeply (\@ran, [qw/h1 h2/], 'true-handled stops at the first true');
+
+$obj->signal_connect (any => sub { TRUE });
+$obj->signal_connect (any => sub { FALSE });
+ok ($obj->signal_emit ('any'), 'logical-or');
+
+for my $n (1 .. 4) {
+  $obj->signal_connect (total => sub { $n });
+}
+is ($obj->signal_emit ('total'), 10, 'sum');
+
+$obj->signal_connect (all => sub { 'a' });
+$obj->signal_connect (all => sub { undef });
+$obj->signal_connect (all => sub { [1, 2] });
+is_deeply ($obj->signal_emit ('all'), ['a', undef, [1, 2], 'class'],
+           'collect keeps handlers returning undef');
+
+$obj->signal_connect (named => sub { 'x' });
+$obj->signal_connect (named => sub { 'y' });
+is ($obj->signal_emit ('named'), 'xy', 'a string names a perl sub');
+
+eval {
+  Glib::Type->register_object ('Glib::Object', 'MyBadAccumulating',
+    signals => { bad => { return_type => 'Glib::String',
+                          flags => 'run-last',
+      accumulator => Glib::Signal::ACCUMULATE_SUM } });
+};
+like ($@, qr/the sum accumulator needs a return type of a numeric type/);
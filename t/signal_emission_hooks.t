@@ -4,7 +4,7 @@
 
 use strict;
 use warnings;
-use Test::More tests => 77;
+use Test::More tests => 87;
 use Glib ':constants';
 
 Glib::Type->register_object (
@@ -144,6 +144,67 @@ is ($emission_count - $n_before, 1, 'two emissions, one hook');
 
 
 
+# lazy hooks: filtered by instance type, parameters converted on demand.
+
+{
+    my @seen;
+    my $kept;
+    my $lazy_hook = Bar->signal_add_emission_hook_lazy (nod => sub {
+        my ($emission, $data) = @_;
+        push @seen, [$emission->signal_name, $emission->n_params,
+                     $emission->param (2), $data];
+        is ($emission->instance, $emission->param (0), 'instance');
+        $kept = $emission;
+        TRUE
+    }, 'lazy data');
+    ok ($lazy_hook, 'added lazy hook');
+
+    my $bar = Glib::Object::new ('Bar');
+    $foo->signal_emit ('nod', 'not a bar', 1);
+    $bar->signal_emit ('nod', 'a bar', 2);
+    $bar->signal_emit ('nod', 'a bar', 3);
+    is_deeply (\@seen, [['nod', 3, 2, 'lazy data'], ['nod', 3, 3, 'lazy data']],
+               'lazy hook only sees emissions on Bars');
+
+    eval { $kept->param (0) };
+    like ($@, qr/emission is over/, 'emission object is only valid in the hook');
+
+    Bar->signal_add_emission_hook_lazy ("wink::$detail" => sub {
+        my ($emission) = @_;
+        is ($emission->detail, $detail, 'detail filter');
+        is_deeply ([map { ref $_ || $_ } $emission->params],
+                   ['Bar', 1], 'all params');
+        eval { $emission->param (2) };
+        like ($@, qr/out of range/);
+        FALSE
+    });
+    $bar->signal_emit ('wink', TRUE);
+    $bar->signal_emit ("wink::$detail", TRUE);
+    $bar->signal_emit ("wink::$detail", TRUE);
+
+    Bar->signal_remove_emission_hook (nod => $lazy_hook);
+    $bar->signal_emit ('nod', 'a bar', 4);
+    is (scalar @seen, 2, 'lazy hook removed');
+}
+
+# a lazy hook whose emission recurses into itself.
+{
+    my @depths;
+    my $bar = Glib::Object::new ('Bar');
+    my $hook = Bar->signal_add_emission_hook_lazy (nod => sub {
+        my ($emission) = @_;
+        my $depth = $emission->param (2);
+        $bar->signal_emit ('nod', 'inner', $depth + 1) if $depth < 2;
+        push @depths, [$depth, $emission->param (2)];
+        TRUE
+    });
+    $bar->signal_emit ('nod', 'outer', 0);
+    is_deeply (\@depths, [[2, 2], [1, 1], [0, 0]],
+               'recursive emissions keep their own emission objects');
+    Bar->signal_remove_emission_hook (nod => $hook);
+}
+
+
 sub generic_hook_no_data {
     my ($ihint, $param_list) = @_;
     print "in hook for $ihint->{signal_name}  $ihint->{run_type}\n";
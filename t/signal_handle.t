@@ -0,0 +1,90 @@
+#!/usr/bin/perl
+
+#
+# Test emission through Glib::Signal handles.
+#
+
+use strict;
+use warnings;
+use Glib;
+use Test::More tests => 14;
+
+package MyEmitter;
+
+use Glib::Object::Subclass
+  'Glib::Object',
+  signals => {
+    added => {
+      param_types => [qw/Glib::Int Glib::String/],
+      return_type => 'Glib::Int',
+      flags => 'run-last',
+    },
+    poked => {
+      flags => [qw/run-last detailed/],
+    },
+  };
+
+sub do_added { return $_[1] + length $_[2] }
+
+package main;
+
+my $sig = Glib::Signal->lookup ('MyEmitter', 'added');
+isa_ok ($sig, 'Glib::Signal');
+
+my $obj = MyEmitter->new;
+is ($sig->emit ($obj, 2, 'abc'), 5, 'return value');
+
+my @seen;
+$obj->signal_connect (added => sub { push @seen, [@_[1,2]]; 0 });
+$sig->emit ($obj, 7, 'x');
+is_deeply (\@seen, [[7, 'x']], 'handler got the arguments');
+
+my @objs = map { MyEmitter->new } 1 .. 3;
+is_deeply ([$sig->emit_many (\@objs, 1, 'ab')], [3, 3, 3],
+           'emit_many returns one value per instance');
+is_deeply ([$sig->emit_many ([], 1, 'ab')], [], 'emit_many on nothing');
+
+# a handler emitting through the same handle
+my $depth = 0;
+$obj->signal_connect (added => sub {
+  my ($o, $n) = @_;
+  $depth++;
+  $sig->emit ($o, $n - 1, 'y') if $n > 0;
+  0
+});
+@seen = ();
+$sig->emit ($obj, 2, 'z');
+is ($depth, 3, 'recursive emission through one handle');
+is_deeply (\@seen, [[2, 'z'], [1, 'y'], [0, 'y']]);
+
+# details are parsed at lookup time
+my $foo = Glib::Signal->lookup ($obj, 'poked::foo');
+my $bar = Glib::Signal->lookup ($obj, 'poked::bar');
+my @pokes;
+$obj->signal_connect ('poked::foo' => sub { push @pokes, 'foo' });
+$foo->emit ($obj);
+$bar->emit ($obj);
+is_deeply (\@pokes, ['foo'], 'detail is honored');
+
+eval { $sig->emit ($obj, 1) };
+like ($@, qr/Incorrect number of arguments/);
+
+eval { $sig->emit (Glib::Object->new, 1, 'a') };
+like ($@, qr/is not of type MyEmitter/);
+
+# a failed emission must not leave the buffer marked as in use
+is ($sig->emit (MyEmitter->new, 1, 'a'), 2, 'still usable after an error');
+
+eval { Glib::Signal->lookup ('MyEmitter', 'no-such-signal') };
+like ($@, qr/Unknown signal/);
+
+eval { $sig->emit_many ($obj, 1, 'a') };
+like ($@, qr/must be an array reference/);
+
+# a handler dropping the last reference to the handle mid-emission
+my $once = Glib::Signal->lookup ('MyEmitter', 'poked');
+my @dropped = map { MyEmitter->new } 1 .. 3;
+my $drops = 0;
+$_->signal_connect (poked => sub { $drops++; undef $once }) for @dropped;
+$once->emit_many (\@dropped);
+is ($drops, 3, 'handle survives being dropped by a handler');
@@ -45,10 +45,68 @@ package main;
 use strict;
 use warnings;
 use Glib;
-use Test::More tests => 1;
+use Test::More tests => 5;
 
 my $obj = MySubClass->new;
 $obj->signal_emit ('mysig');
 
 is($MySubClass::MYSIG_RUNS, 1,
    'marshaling a signal with no return type');
+
+
+# the class closure method is looked up once per class and signal, but
+# must follow redefinitions and overrides
+package MyRedefClass;
+use Glib::Object::Subclass
+  'Glib::Object',
+  signals => { 'poke-it' => {} };
+
+our @POKES;
+sub do_poke_it { push @POKES, 'original' }
+
+package MyRedefChild;
+use Glib::Object::Subclass 'MyRedefClass';
+
+package main;
+
+my $redef = MyRedefClass->new;
+my $child = MyRedefChild->new;
+$redef->signal_emit ('poke-it');
+$child->signal_emit ('poke-it');
+is_deeply (\@MyRedefClass::POKES, [qw/original original/],
+           'class closure method found');
+
+{
+  no warnings 'redefine';
+  *MyRedefClass::do_poke_it = sub { push @MyRedefClass::POKES, 'redefined' };
+}
+@MyRedefClass::POKES = ();
+$redef->signal_emit ('poke-it');
+$child->signal_emit ('poke-it');
+is_deeply (\@MyRedefClass::POKES, [qw/redefined redefined/],
+           'redefined class closure method is used');
+
+*MyRedefChild::do_poke_it = sub { push @MyRedefClass::POKES, 'child' };
+@MyRedefClass::POKES = ();
+$redef->signal_emit ('poke-it');
+$child->signal_emit ('poke-it');
+is_deeply (\@MyRedefClass::POKES, [qw/redefined child/],
+           'method added in a subclass overrides');
+
+# a wrapper reblessed into an unregistered package gets that package's
+# method
+package MyReblessed;
+our @ISA = ('MyRedefClass');
+sub do_poke_it { push @MyRedefClass::POKES, 'reblessed' }
+
+package main;
+
+my $reblessed = MyRedefClass->new;
+$reblessed->signal_emit ('poke-it');
+bless $reblessed, 'MyReblessed';
+$reblessed->signal_emit ('poke-it');
+@MyRedefClass::POKES = ();
+$reblessed->signal_emit ('poke-it');
+$redef->signal_emit ('poke-it');
+is_deeply (\@MyRedefClass::POKES, [qw/reblessed redefined/],
+           'class closure method follows the blessed package');
@@ -0,0 +1,138 @@
+#!/usr/bin/perl
+
+#
+# Test event sources implemented in perl.
+#
+
+use strict;
+use warnings;
+use Glib qw(TRUE FALSE);
+use Test::More tests => 14;
+
+package CountdownSource;
+
+use Glib qw(TRUE FALSE);
+use base 'Glib::Source';
+
+sub new {
+  my ($class, $count) = @_;
+  my $self = $class->SUPER::new;
+  $self->{count} = $count;
+  $self->{runs} = 0;
+  return $self;
+}
+
+sub prepare { return (FALSE, 1) }
+
+sub check { return TRUE }
+
+sub dispatch {
+  my ($self) = @_;
+  $self->{runs}++;
+  return --$self->{count} > 0;
+}
+
+sub finalize { $main::finalized++ }
+
+package main;
+
+our $finalized = 0;
+
+my $loop = Glib::MainLoop->new;
+
+my $source = CountdownSource->new (3);
+isa_ok ($source, 'Glib::Source');
+
+$source->set_priority (Glib::G_PRIORITY_HIGH);
+is ($source->get_priority, Glib::G_PRIORITY_HIGH);
+
+my $id = $source->attach;
+ok ($id > 0, 'attach returns an id');
+is ($source->get_id, $id);
+
+Glib::Timeout->add (100, sub { $loop->quit; FALSE });
+$loop->run;
+
+is ($source->{runs}, 3, 'dispatched until it returned false');
+SKIP: {
+  skip 'is_destroyed needs glib 2.12', 1
+    unless Glib->CHECK_VERSION (2, 12, 0);
+  ok ($source->is_destroyed, 'source was destroyed');
+}
+
+undef $source;
+is ($finalized, 1, 'finalize runs when the object goes away');
+
+# a source that is ready right away and stops itself
+package OnceSource;
+use base 'Glib::Source';
+sub prepare { return 1 }
+sub dispatch { $_[0]{ran}++; return 0 }
+
+package main;
+
+my $once = OnceSource->new;
+$once->attach;
+Glib::Timeout->add (50, sub { $loop->quit; FALSE });
+$loop->run;
+is ($once->{ran}, 1, 'missing check is fine when prepare says ready');
+
+# methods redefined while the source is attached are picked up
+package SwitchSource;
+use base 'Glib::Source';
+sub prepare { return 1 }
+sub dispatch {
+  $_[0]{log} .= 'a';
+  no warnings 'redefine';
+  *SwitchSource::dispatch = sub { $_[0]{log} .= 'b'; 0 };
+  return 1;
+}
+
+package main;
+
+my $switch = SwitchSource->new;
+$switch->attach;
+Glib::Timeout->add (50, sub { $loop->quit; FALSE });
+$loop->run;
+is ($switch->{log}, 'ab', 'redefined dispatch is called');
+
+# exceptions go to the exception handlers
+package DyingSource;
+use base 'Glib::Source';
+sub prepare { return 1 }
+sub dispatch { die "oops\n" }
+
+package main;
+
+my $tag = Glib->install_exception_handler (sub {
+  like ($_[0], qr/oops/, 'exception handler called');
+  0
+});
+my $dying = DyingSource->new;
+$dying->attach;
+Glib::Timeout->add (50, sub { $loop->quit; FALSE });
+$@ = "outer\n";
+$loop->run;
+is ($@, "outer\n", '$@ survives the failed dispatch');
+SKIP: {
+  skip 'is_destroyed needs glib 2.12', 1
+    unless Glib->CHECK_VERSION (2, 12, 0);
+  ok ($dying->is_destroyed, 'dying source was destroyed');
+}
+
+# a dying finalize is reported and the source still goes away
+package DyingFinalizeSource;
+use base 'Glib::Source';
+sub finalize { die "no finalize\n" }
+
+package main;
+
+my @errors;
+Glib->install_exception_handler (sub { push @errors, $_[0]; 0 });
+my $dying_finalize = DyingFinalizeSource->new;
+$dying_finalize->attach;
+undef $dying_finalize;
+is_deeply (\@errors, ["no finalize\n"], 'finalize exception is handled');
+
+eval { Glib::Source::attach ('nope') };
+like ($@, qr/is not a Glib::Source object/);
@@ -0,0 +1,70 @@
+#!/usr/bin/perl
+
+#
+# Test Glib::TimerQueue.
+#
+
+use strict;
+use warnings;
+use Glib qw(TRUE FALSE);
+use Test::More;
+
+unless (Glib->CHECK_VERSION (2, 28, 0)) {
+  plan skip_all => 'Glib::TimerQueue needs glib 2.28';
+} else {
+  plan tests => 12;
+}
+
+my $loop = Glib::MainLoop->new;
+my $queue = Glib::TimerQueue->new;
+isa_ok ($queue, 'Glib::TimerQueue');
+
+my @fired;
+my $repeats = 0;
+
+$queue->add (30, sub { push @fired, 'thirty'; FALSE });
+$queue->add (10, sub { push @fired, $_[0]; FALSE }, 'ten');
+my $doomed = $queue->add (20, sub { push @fired, 'doomed'; FALSE });
+$queue->add (5, sub { $repeats++ < 2 });
+is ($queue->count, 4);
+
+ok ($queue->remove ($doomed), 'remove a pending timer');
+ok (!$queue->remove ($doomed), 'cannot remove it twice');
+is ($queue->count, 3);
+
+# a timer that cancels one which is due in the same round
+my $victim;
+$queue->add (40, sub { $queue->remove ($victim); FALSE });
+$victim = $queue->add (40, sub { push @fired, 'victim'; FALSE });
+
+$queue->add (60, sub { $loop->quit; FALSE });
+Glib::Timeout->add (5000, sub { $loop->quit; FALSE }); # safety net
+
+$loop->run;
+
+is_deeply (\@fired, [qw/ten thirty/], 'timers ran in order');
+is ($repeats, 3, 'repeating timer ran until it returned false');
+is ($queue->count, 0, 'queue is empty');
+
+# exceptions in callbacks go to the exception handlers and stop the timer
+my $tag = Glib->install_exception_handler (sub {
+  like ($_[0], qr/oops/, 'exception handler called');
+  0
+});
+my $id = $queue->add (0, sub { die "oops\n" });
+$queue->add (20, sub { $loop->quit; FALSE });
+$loop->run;
+ok (!$queue->remove ($id), 'dying timer was removed');
+
+# the queue goes away with its last reference
+my $ran = 0;
+{
+  my $short_lived = Glib::TimerQueue->new;
+  $short_lived->add (0, sub { $ran++; FALSE });
+}
+Glib::Timeout->add (20, sub { $loop->quit; FALSE });
+$loop->run;
+is ($ran, 0, 'destroyed queue does not run its timers');
+
+eval { Glib::TimerQueue::add ('nope', 10, sub {}) };
+like ($@, qr/is not of type Glib::TimerQueue/);
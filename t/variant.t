@@ -14,7 +14,7 @@ use constant {
 };
 
 if (Glib->CHECK_VERSION (2, 24, 0)) {
-  plan tests => 223;
+  plan tests => 256;
 } else {
   plan skip_all => 'Need libglib >= 2.24';
 }
@@ -339,6 +339,32 @@ note ('convenience constructor and accessor');
     my $v3 = Glib::Variant->new ('a{si}', {'äöü' => 23, 'Perl' => 42, '💑' => 2342});
     is_deeply ($v2->get ('a{si}'), [['äöü', 23], ['Perl', 42], ['💑', 2342]]);
   }
+
+  note (' errors');
+  {
+    eval { Glib::Variant->new ('(si)', ['äöü']) };
+    like ($@, qr/Expected an array ref with 2 elements/);
+
+    eval { Glib::Variant->new ('as', 'Perl') };
+    like ($@, qr/Expected an array ref/);
+
+    eval { Glib::Variant->new ('o', 'not a path') };
+    like ($@, qr/not a valid object path/);
+
+    eval { Glib::Variant->new ('a?', []) };
+    like ($@, qr/Cannot handle the part 'a\?'/);
+
+    eval { Glib::Variant->new ('i', 23)->get ('s') };
+    like ($@, qr/Cannot read a variant of type 'i' with the format 's'/);
+    # a croak while containers are half built unwinds cleanly
+    {
+      package DyingString;
+      use overload '""' => sub { die "no string for you\n" };
+    }
+    my $dying = bless {}, 'DyingString';
+    eval { Glib::Variant->new ('a(sas)', [['a', ['b', $dying]]]) };
+    is ($@, "no string for you\n");
+  }
 }
 
 note ('variant dict');
@@ -370,3 +396,75 @@ SKIP: {
   is ($d_v->lookup_value ('Perl', 'u')->get_uint32 (), $v->lookup_value ('Perl', 'u')->get_uint32 ());
   is ($d_v->lookup_value ('💑', 't')->get_uint64 (), $v->lookup_value ('💑', 't')->get_uint64 ());
 }
+
+note ('serialized data');
+SKIP: {
+  skip 'serialized data', 6
+    unless Glib->CHECK_VERSION (2, 36, 0);
+
+  my $v = Glib::Variant->new ('(sai)', ['Perl', [23, 42]]);
+  my $bytes = $v->get_data_as_bytes;
+  isa_ok ($bytes, 'Glib::Bytes');
+  is ($bytes->get_size, $v->get_size);
+
+  my $v2 = Glib::Variant->new_from_bytes ('(sai)', $bytes);
+  ok ($v2->equal ($v));
+  is_deeply ($v2->get ('(sai)'), ['Perl', [23, 42]]);
+
+  require File::Temp;
+  my ($fh, $filename) = File::Temp::tempfile (UNLINK => 1);
+  binmode $fh;
+  print $fh $bytes->get_data;
+  close $fh;
+  my $v3 = Glib::Variant->new_from_file ('(sai)', $filename, TRUE);
+  is_deeply ($v3->get ('(sai)'), ['Perl', [23, 42]]);
+
+  eval { Glib::Variant->new_from_file ('(sai)', "$filename.does-not-exist") };
+  isa_ok ($@, 'Glib::File::Error');
+}
+
+note ('views');
+{
+  my $v = Glib::Variant->new ('a{sv}', {
+    'name' => Glib::Variant->new ('s', 'äöü'),
+    'list' => Glib::Variant->new ('a(si)', [['Perl', 23], ['💑', 42]]),
+    'maybe' => Glib::Variant->new ('mi', undef)});
+  my $view = $v->view;
+  is (ref $view, 'HASH');
+  ok (tied %$view);
+  is (scalar keys %$view, 3);
+  ok (exists $view->{list});
+  ok (!exists $view->{nope});
+  is ($view->{nope}, undef);
+
+  my $name = $view->{name};
+  isa_ok ($name, 'Glib::Variant');
+  is ($name->get ('s'), 'äöü');
+
+  my $list = $view->{list}->view;
+  is (ref $list, 'ARRAY');
+  is (scalar @$list, 2);
+  is_deeply ([@{$list->[1]}], ['💑', 42]);
+  is ($list->[-1][0], '💑');
+  is ($list->[5], undef);
+
+  is_deeply ([sort keys %$view], [qw/list maybe name/]);
+
+  eval { $view->{name} = 1 };
+  like ($@, qr/read-only/);
+  eval { push @$list, 1 };
+  like ($@, qr/read-only/);
+
+  is (Glib::Variant->new ('i', 23)->view, 23);
+  is (Glib::Variant->new ('mi', undef)->view, undef);
+  is_deeply ([@{Glib::Variant->new ('a{ii}', [[1, 2]])->view->[0]}], [1, 2]);
+
+  # like lookups, iteration only sees the first of duplicate keys
+  my $dups = Glib::Variant->new ('a{si}', [['a', 1], ['b', 2], ['a', 3]])->view;
+  is (scalar keys %$dups, 2);
+  my %copy;
+  while (my ($key, $value) = each %$dups) {
+    $copy{$key} = $value;
+  }
+  is_deeply (\%copy, {a => 1, b => 2});
+}